@@ -0,0 +1,218 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+#include "Artifacts.h"
+#include "Debug.h"
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace psyche;
+
+Artifacts& Artifacts::instance()
+{
+    // Never destroyed: the exit handler may still need it.
+    static Artifacts* artifacts = new Artifacts;
+    return *artifacts;
+}
+
+Artifacts::Artifacts()
+{
+    // A run that exits on an error does not come back to its caller, which
+    // would have written the artifacts kept for it.
+    std::atexit([] {
+        Artifacts& artifacts = Artifacts::instance();
+        artifacts.fail();
+        artifacts.stop();
+    });
+
+    // Nor does one that crashes, which is when they are needed the most.
+    if (artifactsMode == ArtifactsMode::OnFailure) {
+        for (int sig : { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL })
+            std::signal(sig, &Artifacts::crashed);
+    }
+}
+
+bool Artifacts::wanted()
+{
+    return artifactsMode != ArtifactsMode::None;
+}
+
+void Artifacts::write(const std::string& fileName, std::string content)
+{
+    if (!wanted())
+        return;
+
+    if (artifactsMode == ArtifactsMode::OnFailure) {
+        Kept* kept = new Kept { Artifact(fileName, std::move(content)), nullptr };
+        std::lock_guard<std::mutex> lock(mutex_);
+        kept->next_ = kept_.load();
+        kept_.store(kept);
+        return;
+    }
+
+    std::vector<Artifact> artifacts;
+    artifacts.emplace_back(fileName, std::move(content));
+    enqueue(std::move(artifacts));
+}
+
+void Artifacts::fail()
+{
+    std::vector<Artifact> artifacts = release();
+    if (!artifacts.empty())
+        enqueue(std::move(artifacts));
+}
+
+void Artifacts::discard()
+{
+    release();
+}
+
+std::vector<Artifacts::Artifact> Artifacts::release()
+{
+    Kept* kept;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        kept = kept_.exchange(nullptr);
+    }
+    // A crash handler that started before the exchange may still be reading
+    // the list: it ends with the process, which is then never freed.
+    while (crashing_.load())
+        std::this_thread::yield();
+
+    std::vector<Artifact> artifacts;
+    while (kept) {
+        Kept* next = kept->next_;
+        artifacts.push_back(std::move(kept->artifact_));
+        delete kept;
+        kept = next;
+    }
+    // In the order they were handed over.
+    std::reverse(artifacts.begin(), artifacts.end());
+    return artifacts;
+}
+
+void Artifacts::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return pending_ == 0; });
+}
+
+void Artifacts::enqueue(std::vector<Artifact> artifacts)
+{
+    if (!asyncArtifacts) {
+        for (const auto& artifact : artifacts)
+            save(artifact);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& artifact : artifacts)
+        queue_.push_back(std::move(artifact));
+    pending_ += artifacts.size();
+    if (!writer_.joinable())
+        writer_ = std::thread(&Artifacts::writerLoop, this);
+    cond_.notify_all();
+}
+
+void Artifacts::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cond_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty())
+            return;
+
+        Artifact artifact = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+        save(artifact);
+        lock.lock();
+        --pending_;
+        cond_.notify_all();
+    }
+}
+
+void Artifacts::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        cond_.notify_all();
+    }
+    // The writer empties the queue before it returns.
+    if (writer_.joinable())
+        writer_.join();
+}
+
+void Artifacts::crashed(int sig)
+{
+    // Best effort, the process is going down anyway: write what is kept, for
+    // every thread, with nothing but open and write (no lock, allocation or
+    // stream is safe in a signal handler), so uncompressed. A crash in here
+    // ends the process.
+    std::signal(sig, SIG_DFL);
+    Artifacts& artifacts = instance();
+    ++artifacts.crashing_;
+    for (const Kept* kept = artifacts.kept_.load(); kept; kept = kept->next_) {
+        const std::string& content = kept->artifact_.second;
+        int fd = open(kept->artifact_.first.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            continue;
+        for (std::size_t done = 0; done < content.size(); ) {
+            ssize_t n = ::write(fd, content.data() + done, content.size() - done);
+            if (n <= 0)
+                break;
+            done += n;
+        }
+        close(fd);
+    }
+    std::raise(sig);
+}
+
+void Artifacts::save(const Artifact& artifact)
+{
+    if (compressArtifacts) {
+#ifdef HAVE_ZLIB
+        std::string fileName = artifact.first + ".gz";
+        gzFile file = gzopen(fileName.c_str(), "wb");
+        if (!file
+                || gzwrite(file, artifact.second.data(), artifact.second.size())
+                        != static_cast<int>(artifact.second.size())) {
+            std::cerr << "Gen: cannot write " << fileName << std::endl;
+        }
+        if (file)
+            gzclose(file);
+        return;
+#endif
+    }
+
+    std::ofstream ofs(artifact.first);
+    ofs << artifact.second;
+    if (!ofs)
+        std::cerr << "Gen: cannot write " << artifact.first << std::endl;
+}
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+#ifndef PSYCHE_ARTIFACTS_H__
+#define PSYCHE_ARTIFACTS_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace psyche {
+
+/*!
+ * \brief The Artifacts class
+ *
+ * The debug files of a run: the .dot files of the ASTs, of the dependence
+ * graphs and of the initialization graphs. What becomes of them depends on
+ * artifactsMode:
+ *  - None: they are not even built (see \ref wanted);
+ *  - OnFailure: they are kept in memory, and written only if the file being
+ *    processed fails (\ref fail, an exit or a crash while some are kept);
+ *  - All: they are written as they come.
+ *
+ * With asyncArtifacts, a background thread writes them, so that the analysis
+ * does not wait for the disk; with compressArtifacts, they are gzipped (but
+ * for the ones written by the crash handler).
+ */
+class Artifacts final
+{
+public:
+    static Artifacts& instance();
+
+    //! Whether the artifacts must be built at all
+    static bool wanted();
+
+    //! Hand over the content of an artifact, written (or kept) per the policy
+    void write(const std::string& fileName, std::string content);
+
+    //! The file being processed failed: write the artifacts kept for it
+    void fail();
+    //! The file being processed succeeded: drop the artifacts kept for it
+    void discard();
+    //! Wait until every artifact handed over is on disk
+    void flush();
+
+private:
+    using Artifact = std::pair<std::string, std::string>;
+
+    //! An artifact kept for a failure, never changed once in the list, so
+    //! that the crash handler can read it
+    struct Kept
+    {
+        Artifact artifact_;
+        Kept* next_;
+    };
+
+    Artifacts();
+    Artifacts(const Artifacts&) = delete;
+    Artifacts& operator=(const Artifacts&) = delete;
+
+    void enqueue(std::vector<Artifact> artifacts);
+    void writerLoop();
+    void stop();
+    std::vector<Artifact> release();
+    static void save(const Artifact& artifact);
+    static void crashed(int sig);
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::atomic<Kept*> kept_ { nullptr }; // The newest first
+    std::atomic<int> crashing_ { 0 }; // Crash handlers reading kept_
+    std::deque<Artifact> queue_;
+    unsigned pending_ { 0 };
+    bool stopping_ { false };
+    std::thread writer_; // Started on the first asynchronous write
+};
+
+} // namespace psyche
+
+#endif
@@ -25,6 +25,24 @@ bool debugEnabled = false;
 bool debugVisit = false; // Edit here to enable visitor debugging.
 bool runingTests = false;
 
+unsigned loopIterations = 8;
+unsigned narrowingPasses = 1;
+
 bool generateCSV = false;
+bool binaryResults = false;
+bool contiguousArrays = false;
+ArenaMode arenaMode = ArenaMode::None;
+GuardMode guardMode = GuardMode::None;
+std::string mainSeed;
+unsigned nbCalls = 10;
+unsigned nbWarmupCalls = 0;
+unsigned sweepCap = 0;
+unsigned sweepRepeats = 10;
+unsigned nbWorkers = 1;
+double budgetMs = 0;
+double ciTarget = 0;
+ArtifactsMode artifactsMode = ArtifactsMode::OnFailure;
+bool asyncArtifacts = false;
+bool compressArtifacts = false;
 
 } // namespace psyche
@@ -26,7 +26,49 @@ extern bool debugEnabled;
 extern bool debugVisit;
 extern bool runingTests;
 
+//! Visits of a loop body that widen to thresholds before the bounds that still
+//! move go to infinity, and narrowing visits after them (see RangeAnalysis).
+extern unsigned loopIterations;
+extern unsigned narrowingPasses;
+
 extern bool generateCSV;
+//! Write the results of the mains packed in binary rather than as a CSV.
+extern bool binaryResults;
+//! Allocate each pointer array of the mains in a single block.
+extern bool contiguousArrays;
+//! Allocate the arrays of the mains in an arena reused from one test to the
+//! next, left in the caches (Warm) or flushed from them (Cold) before the call.
+enum class ArenaMode { None, Warm, Cold };
+extern ArenaMode arenaMode;
+//! Allocate each block of the arrays of the mains against a guard page that
+//! faults on the first access after its end (End) or before its start (Start).
+enum class GuardMode { None, End, Start };
+extern GuardMode guardMode;
+//! Default seed of the mains (empty to seed them with the time).
+extern std::string mainSeed;
+//! Calls of the function timed by each test of the mains, and calls made
+//! before them to warm up the caches and the branch predictors.
+extern unsigned nbCalls;
+extern unsigned nbWarmupCalls;
+//! Sweep the independent array sizes of the mains over MIN_ARRAY_SIZE,
+//! 2 * MIN_ARRAY_SIZE, ... up to sweepCap (0 for random sizes), each size
+//! being tested sweepRepeats times.
+extern unsigned sweepCap;
+extern unsigned sweepRepeats;
+//! Budget of time (ms) of the tests of the mains, and relative half-width of
+//! the confidence interval of their mean latency at which they stop (0 for
+//! none, NB_TESTS tests then).
+extern double budgetMs;
+extern double ciTarget;
+//! Processes between which the mains split their tests.
+extern unsigned nbWorkers;
+//! When the debug artifacts (.dot files) are written: never, only for the
+//! files whose analysis fails, or always. They may be written on a background
+//! thread, and gzipped.
+enum class ArtifactsMode { None, OnFailure, All };
+extern ArtifactsMode artifactsMode;
+extern bool asyncArtifacts;
+extern bool compressArtifacts;
 
 #define PSYCHE_COMPONENT "psyche"
 
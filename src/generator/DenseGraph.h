@@ -0,0 +1,297 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+#ifndef PSYCHE_DENSEGRAPH_H__
+#define PSYCHE_DENSEGRAPH_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace psyche {
+
+/*!
+ * \brief The DenseGraph class
+ *
+ * A directed graph whose vertices are numbered densely, in the order they are
+ * inserted, and whose edges carry a (possibly empty) set of integer labels.
+ *
+ * The graph has two phases. While it is built, each vertex keeps its own
+ * lists of edges, so that vertices and edges can be inserted and removed.
+ * \ref freeze then packs the edges in compressed sparse rows (CSR), in which
+ * the edges leaving (or entering) a vertex, and their labels, are contiguous:
+ * this is what \ref outEdges and \ref inEdges walk. Modifying the graph
+ * thaws it.
+ *
+ * The vertices are always visited in the order of their insertion, whatever
+ * their values, so anything derived from the graph is stable from run to run.
+ */
+template <class VertexT>
+class DenseGraph
+{
+public:
+    using Id = unsigned;
+    static constexpr Id npos = static_cast<Id>(-1);
+
+    //! An edge of the CSR: the vertex at its other end, and its labels.
+    struct Edge
+    {
+        Id vertex_;
+        unsigned firstLabel_;
+        unsigned lastLabel_;
+    };
+
+    //! A contiguous range of the CSR.
+    template <class T>
+    class Slice
+    {
+    public:
+        Slice(const T* first, const T* last) : first_(first), last_(last) {}
+        const T* begin() const { return first_; }
+        const T* end() const { return last_; }
+        std::size_t size() const { return last_ - first_; }
+        bool empty() const { return first_ == last_; }
+
+    private:
+        const T* first_;
+        const T* last_;
+    };
+
+    //! Iterates over the vertices still in the graph, in insertion order.
+    class const_iterator
+    {
+    public:
+        const_iterator(const DenseGraph* graph, Id id) : graph_(graph), id_(id) { skip(); }
+
+        const VertexT& operator*() const { return graph_->vertices_[id_]; }
+        Id id() const { return id_; }
+        const_iterator& operator++() { ++id_; skip(); return *this; }
+        const_iterator operator++(int) { const_iterator it = *this; ++*this; return it; }
+        bool operator==(const const_iterator& other) const { return id_ == other.id_; }
+        bool operator!=(const const_iterator& other) const { return id_ != other.id_; }
+
+    private:
+        void skip()
+        {
+            while (id_ < graph_->alive_.size() && !graph_->alive_[id_])
+                ++id_;
+        }
+
+        const DenseGraph* graph_;
+        Id id_;
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, vertices_.size()); }
+
+    //! Number of vertices still in the graph
+    std::size_t size() const { return size_; }
+    //! Upper bound of the ids, for tables indexed by them
+    std::size_t capacity() const { return vertices_.size(); }
+    bool contains(Id id) const { return id < alive_.size() && alive_[id]; }
+    const VertexT& vertex(Id id) const { return vertices_[id]; }
+
+    //! The id of a vertex, or npos if it is not in the graph
+    Id id(const VertexT& vertex) const
+    {
+        auto it = ids_.find(vertex);
+        return it == ids_.end() ? npos : it->second;
+    }
+
+    void clear()
+    {
+        vertices_.clear();
+        alive_.clear();
+        ids_.clear();
+        out_.clear();
+        in_.clear();
+        size_ = 0;
+        thaw();
+    }
+
+    //! Insert a vertex, unless it is already in the graph
+    //! \return Its id
+    Id insertVertex(const VertexT& vertex)
+    {
+        auto it = ids_.find(vertex);
+        if (it != ids_.end())
+            return it->second;
+        thaw();
+        Id id = vertices_.size();
+        vertices_.push_back(vertex);
+        alive_.push_back(true);
+        out_.emplace_back();
+        in_.emplace_back();
+        ids_.emplace(vertex, id);
+        ++size_;
+        return id;
+    }
+
+    //! Remove a vertex and its edges. Its id is not reused.
+    void removeVertex(Id id)
+    {
+        if (!contains(id))
+            return;
+        thaw();
+        for (const auto& edge : out_[id])
+            erase(in_[edge.first], id);
+        for (Id parent : in_[id]) {
+            auto& edges = out_[parent];
+            edges.erase(std::find_if(edges.begin(), edges.end(),
+                                     [id](const BuildEdge& edge) { return edge.first == id; }));
+        }
+        out_[id].clear();
+        in_[id].clear();
+        ids_.erase(vertices_[id]);
+        alive_[id] = false;
+        --size_;
+    }
+
+    //! Insert the edge from -> to, unless it is already in the graph
+    void insertEdge(Id from, Id to)
+    {
+        buildEdge(from, to);
+    }
+
+    //! Insert the edge from -> to if needed, and add a label to it
+    void insertEdge(Id from, Id to, int label)
+    {
+        auto& labels = buildEdge(from, to);
+        auto it = std::lower_bound(labels.begin(), labels.end(), label);
+        if (it == labels.end() || *it != label)
+            labels.insert(it, label);
+    }
+
+    std::size_t outDegree(Id id) const { return out_[id].size(); }
+    std::size_t inDegree(Id id) const { return in_[id].size(); }
+
+    //! The vertices at the end of the edges leaving a vertex (in any phase)
+    std::vector<Id> outNeighbors(Id id) const
+    {
+        std::vector<Id> ret;
+        ret.reserve(out_[id].size());
+        for (const auto& edge : out_[id])
+            ret.push_back(edge.first);
+        return ret;
+    }
+
+    //! The vertices at the start of the edges entering a vertex (in any phase)
+    std::vector<Id> inNeighbors(Id id) const { return in_[id]; }
+
+    //! Pack the edges in CSR, for \ref outEdges, \ref inEdges and \ref labels
+    void freeze()
+    {
+        if (frozen_)
+            return;
+        const std::size_t n = vertices_.size();
+        outOffsets_.assign(n + 1, 0);
+        inOffsets_.assign(n + 1, 0);
+        outEdges_.clear();
+        labels_.clear();
+        for (Id id = 0; id < n; ++id) {
+            outOffsets_[id] = outEdges_.size();
+            for (const auto& edge : out_[id]) {
+                unsigned first = labels_.size();
+                labels_.insert(labels_.end(), edge.second.begin(), edge.second.end());
+                outEdges_.push_back(Edge { edge.first, first, static_cast<unsigned>(labels_.size()) });
+                ++inOffsets_[edge.first + 1];
+            }
+        }
+        outOffsets_[n] = outEdges_.size();
+
+        // The edges entering a vertex share the labels of the edges leaving
+        // their sources.
+        for (Id id = 0; id < n; ++id)
+            inOffsets_[id + 1] += inOffsets_[id];
+        inEdges_.resize(outEdges_.size());
+        std::vector<unsigned> next(inOffsets_.begin(), inOffsets_.end() - 1);
+        for (Id id = 0; id < n; ++id) {
+            for (unsigned e = outOffsets_[id]; e < outOffsets_[id + 1]; ++e) {
+                const Edge& edge = outEdges_[e];
+                inEdges_[next[edge.vertex_]++] = Edge { id, edge.firstLabel_, edge.lastLabel_ };
+            }
+        }
+        frozen_ = true;
+    }
+
+    bool frozen() const { return frozen_; }
+
+    //! The edges leaving a vertex \pre frozen()
+    Slice<Edge> outEdges(Id id) const
+    {
+        return Slice<Edge>(outEdges_.data() + outOffsets_[id], outEdges_.data() + outOffsets_[id + 1]);
+    }
+
+    //! The edges entering a vertex \pre frozen()
+    Slice<Edge> inEdges(Id id) const
+    {
+        return Slice<Edge>(inEdges_.data() + inOffsets_[id], inEdges_.data() + inOffsets_[id + 1]);
+    }
+
+    //! The labels of an edge, in increasing order \pre frozen()
+    Slice<int> labels(const Edge& edge) const
+    {
+        return Slice<int>(labels_.data() + edge.firstLabel_, labels_.data() + edge.lastLabel_);
+    }
+
+private:
+    using BuildEdge = std::pair<Id, std::vector<int> >;
+
+    std::vector<int>& buildEdge(Id from, Id to)
+    {
+        thaw();
+        auto& edges = out_[from];
+        for (auto& edge : edges) {
+            if (edge.first == to)
+                return edge.second;
+        }
+        edges.emplace_back(to, std::vector<int>());
+        in_[to].push_back(from);
+        return edges.back().second;
+    }
+
+    static void erase(std::vector<Id>& ids, Id id)
+    {
+        ids.erase(std::find(ids.begin(), ids.end(), id));
+    }
+
+    void thaw() { frozen_ = false; }
+
+    // Build phase
+    std::vector<VertexT> vertices_;
+    std::vector<bool> alive_;
+    std::unordered_map<VertexT, Id> ids_;
+    std::vector<std::vector<BuildEdge> > out_;
+    std::vector<std::vector<Id> > in_;
+    std::size_t size_ { 0 };
+
+    // Frozen phase
+    bool frozen_ { false };
+    std::vector<unsigned> outOffsets_;
+    std::vector<Edge> outEdges_;
+    std::vector<unsigned> inOffsets_;
+    std::vector<Edge> inEdges_;
+    std::vector<int> labels_;
+};
+
+} // namespace psyche
+
+#endif
@@ -24,6 +24,7 @@
 
 #include "DependenceGraph.h"
 #include "AST.h"
+#include "Artifacts.h"
 #include "Bind.h"
 #include "Assert.h"
 #include "Debug.h"
@@ -34,13 +35,19 @@
 #include "TranslationUnit.h"
 #include "NodeDependenceGraph.h"
 #include "Utils.h"
+#include <algorithm>
+#include <deque>
 #include <queue>
 #include <fstream>
+#include <iostream>
+#include <list>
 #include <sstream>
+#include <string>
 
 #define VISITOR_NAME "NodeDepGraph"
 
 using namespace psyche;
+using namespace std;
 
 DependenceGraph::DependenceGraph()
 {
@@ -50,7 +57,7 @@ DependenceGraph::DependenceGraph()
 DependenceGraph::~DependenceGraph()
 {
     for (auto it = graph_.begin(); it != graph_.end(); ++it){
-        deleteNode(it->first);
+        deleteNode(*it);
     }
     graph_.clear();
 }
@@ -58,64 +65,192 @@ DependenceGraph::~DependenceGraph()
 void DependenceGraph::clear()
 {
     for (auto it = graph_.begin(); it != graph_.end(); ++it){
-        deleteNode(it->first);
+        deleteNode(*it);
     }
     graph_.clear();
+    symbolIndex_.clear();
+    newestByName_.clear();
+    newestBySymbol_.clear();
+    formulaIndex_.clear();
+    productIndex_.clear();
     std::cout << ANSI_COLOR_GREEN << "[DependenceGraph] Graph cleared."
               << ANSI_COLOR_RESET << std::endl;
 }
 
+unsigned DependenceGraph::insert(NodeDependenceGraph *node)
+{
+    unsigned id = graph_.id(node);
+    if (id == graph_.npos) {
+        id = graph_.insertVertex(node);
+        index(node);
+    }
+    return id;
+}
+
+void DependenceGraph::remove(NodeDependenceGraph *node)
+{
+    unindex(node);
+    graph_.removeVertex(graph_.id(node));
+}
+
+void DependenceGraph::index(NodeDependenceGraph *node)
+{
+    for (auto symb : node->symbols()) {
+        if (!symb->name())
+            continue;
+        auto& nodes = symbolIndex_[symb->name()];
+        if (std::find(nodes.begin(), nodes.end(), node) == nodes.end())
+            nodes.push_back(node);
+        NodeDependenceGraph*& newest = node->isArray() ? newestBySymbol_[symb]
+                                                       : newestByName_[symb->name()];
+        if (!newest || graph_.id(node) > graph_.id(newest))
+            newest = node;
+    }
+    if (node->type() == NTAffine) {
+        auto& nodes = formulaIndex_[static_cast<AffineNode*>(node)->formulaId()];
+        if (std::find(nodes.begin(), nodes.end(), node) == nodes.end())
+            nodes.push_back(node);
+    } else if (node->type() == NTProduct) {
+        auto& nodes = productIndex_[static_cast<ProductNode*>(node)->parents()];
+        if (std::find(nodes.begin(), nodes.end(), node) == nodes.end())
+            nodes.push_back(node);
+    }
+}
+
+void DependenceGraph::unindex(NodeDependenceGraph *node)
+{
+    for (auto symb : node->symbols()) {
+        auto bucket = symbolIndex_.find(symb->name());
+        if (bucket == symbolIndex_.end())
+            continue;
+        bucket->second.erase(std::remove(bucket->second.begin(), bucket->second.end(), node),
+                             bucket->second.end());
+        // The next newest node of the symbol is in the rest of the bucket.
+        NodeDependenceGraph*& newest = node->isArray() ? newestBySymbol_[symb]
+                                                       : newestByName_[symb->name()];
+        if (newest != node)
+            continue;
+        newest = NULL;
+        for (auto other : bucket->second) {
+            if (other->isArray() == node->isArray() && other->is(symb)
+                    && (!newest || graph_.id(other) > graph_.id(newest)))
+                newest = other;
+        }
+    }
+    if (node->type() == NTAffine) {
+        auto& nodes = formulaIndex_[static_cast<AffineNode*>(node)->formulaId()];
+        nodes.erase(std::remove(nodes.begin(), nodes.end(), node), nodes.end());
+    } else if (node->type() == NTProduct) {
+        auto& nodes = productIndex_[static_cast<ProductNode*>(node)->parents()];
+        nodes.erase(std::remove(nodes.begin(), nodes.end(), node), nodes.end());
+    }
+}
+
+std::vector<NodeDependenceGraph*> DependenceGraph::nodesOf(const CPlusPlus::Symbol *symb)
+{
+    std::vector<NodeDependenceGraph*> nodes;
+    auto bucket = symbolIndex_.find(symb->name());
+    if (bucket == symbolIndex_.end())
+        return nodes;
+    // The bucket holds every node with a symbol of that name, arrays only
+    // are the exact symbols they hold.
+    for (auto node : bucket->second) {
+        if (node->is(symb))
+            nodes.push_back(node);
+    }
+    std::sort(nodes.begin(), nodes.end(), [this](NodeDependenceGraph* a, NodeDependenceGraph* b) {
+        return graph_.id(a) < graph_.id(b);
+    });
+    return nodes;
+}
+
+NodeDependenceGraph *DependenceGraph::equalNode(NodeDependenceGraph *node)
+{
+    // Arrays are equal if they share a symbol, scalars if they have the same,
+    // affine nodes if they have the same formula, products if they have the
+    // same parents: they are in the same buckets.
+    std::vector<NodeDependenceGraph*> candidates;
+    for (auto symb : node->symbols()) {
+        auto bucket = symbolIndex_.find(symb->name());
+        if (bucket != symbolIndex_.end())
+            candidates.insert(candidates.end(), bucket->second.begin(), bucket->second.end());
+    }
+    if (node->type() == NTAffine) {
+        auto bucket = formulaIndex_.find(static_cast<AffineNode*>(node)->formulaId());
+        if (bucket != formulaIndex_.end())
+            candidates.insert(candidates.end(), bucket->second.begin(), bucket->second.end());
+    } else if (node->type() == NTProduct) {
+        auto bucket = productIndex_.find(static_cast<ProductNode*>(node)->parents());
+        if (bucket != productIndex_.end())
+            candidates.insert(candidates.end(), bucket->second.begin(), bucket->second.end());
+    }
+
+    NodeDependenceGraph* oldest = NULL;
+    for (auto candidate : candidates) {
+        if (candidate != node && *candidate == *node &&
+            (!oldest || graph_.id(candidate) < graph_.id(oldest)))
+            oldest = candidate;
+    }
+    return oldest;
+}
+
 NodeDependenceGraph *DependenceGraph::find(const CPlusPlus::Symbol *symb)
 {
     if (!symb->name())
         return NULL;
-    // Starting from the end to have the most recent node
-    for (auto it = graph_.rbegin(); it != graph_.rend(); ++it){
-        if (it->first->is(symb))
-            return it->first;
-    }
-    return NULL;
+    // The most recent node: an array holding the symbol, or another node of
+    // the same name.
+    NodeDependenceGraph* newest = NULL;
+    auto array = newestBySymbol_.find(symb);
+    if (array != newestBySymbol_.end())
+        newest = array->second;
+    auto other = newestByName_.find(symb->name());
+    if (other != newestByName_.end() && other->second
+            && (!newest || graph_.id(other->second) > graph_.id(newest)))
+        newest = other->second;
+    return newest;
 }
 
 NodeDependenceGraph *DependenceGraph::find(AffineNode *expr)
 {
     if (!expr)
         return NULL;
-    // Starting from the end to have the most recent node
-    for (auto it = graph_.rbegin(); it != graph_.rend(); ++it){
-        if (*expr == *(it->first))
-            return it->first;
+    // The most recent node
+    auto bucket = formulaIndex_.find(expr->formulaId());
+    if (bucket == formulaIndex_.end())
+        return NULL;
+    NodeDependenceGraph* newest = NULL;
+    for (auto node : bucket->second) {
+        if (*expr == *node && (!newest || graph_.id(node) > graph_.id(newest)))
+            newest = node;
     }
-    return NULL;
+    return newest;
 }
 
 NodeDependenceGraph* DependenceGraph::addNode(NodeDependenceGraph *node)
 {
-    auto exist = graph_.find(node);
-    if (exist != graph_.end()) {
-        return exist->first;
+    if (!node)
+        return node;
+    if (graph_.id(node) != graph_.npos) {
+        return node;
     }
-    for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        if (*(it->first) == *node) {
-            auto oldNode = it->first;
-            oldNode->merge(*node);
-            graph_.remove_vertex(node);
-            deleteNode(node);
-            return oldNode;
-        }
+    if (auto oldNode = equalNode(node)) {
+        oldNode->merge(*node);
+        index(oldNode);
+        deleteNode(node);
+        return oldNode;
     }
-    if (node)
-        graph_.insert_vertex(node);
+    insert(node);
     return node;
 }
 
 void DependenceGraph::addEdge(NodeDependenceGraph *parent, const CPlusPlus::Symbol *childSymb)
 {
-    if (!parent || !childSymb)
+    if (!parent || !childSymb || !childSymb->name())
         return;
-    for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        if (it->first->is(childSymb) && (it->first) != parent) {
-            graph_.insert_edge(parent, it->first);
+    for (auto child : nodesOf(childSymb)) {
+        if (child != parent) {
+            graph_.insertEdge(insert(parent), graph_.id(child));
             return;
         }
     }
@@ -123,12 +258,11 @@ void DependenceGraph::addEdge(NodeDependenceGraph *parent, const CPlusPlus::Symb
 
 void DependenceGraph::addLabeledEdge(NodeDependenceGraph *parent, const CPlusPlus::Symbol *childSymb, int dim)
 {
-    if (!parent || !childSymb)
+    if (!parent || !childSymb || !childSymb->name())
         return;
-    for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        if (it->first->is(childSymb) && (it->first) != parent) {
-            graph_.insert_edge(parent, it->first);
-            labelEdges_[std::make_pair(parent, it->first)].insert(dim);
+    for (auto child : nodesOf(childSymb)) {
+        if (child != parent) {
+            graph_.insertEdge(insert(parent), graph_.id(child), dim);
             return;
         }
     }
@@ -140,7 +274,7 @@ void DependenceGraph::addEdge(NodeDependenceGraph *parent, NodeDependenceGraph *
         return;
     parent = addNode(parent);
     child = addNode(child);
-    graph_.insert_edge(parent, child);
+    graph_.insertEdge(insert(parent), insert(child));
 }
 
 void DependenceGraph::merge(NodeDependenceGraph *first, NodeDependenceGraph *second)
@@ -148,27 +282,31 @@ void DependenceGraph::merge(NodeDependenceGraph *first, NodeDependenceGraph *sec
     PSYCHE_ASSERT(first, return, "trying to merge a non-existing node");
     PSYCHE_ASSERT(second, return, "trying to merge a non-existing node");
 
-    const NGraph::tGraph<NodeDependenceGraph*>::vertex_set children = graph_.out_neighbors(second);
-    for (auto it = children.begin(); it != children.end(); it++) {
-        addEdge(first, *it);
-    }
-    const NGraph::tGraph<NodeDependenceGraph*>::vertex_set parents = graph_.in_neighbors(second);
-    for (auto it = parents.begin(); it != parents.end(); it++) {
-        addEdge(*it, first);
+    const auto secondId = graph_.id(second);
+    if (secondId != graph_.npos) {
+        for (auto child : graph_.outNeighbors(secondId)) {
+            addEdge(first, graph_.vertex(child));
+        }
+        for (auto parent : graph_.inNeighbors(secondId)) {
+            addEdge(graph_.vertex(parent), first);
+        }
+        remove(second);
     }
     first->merge(*second);
-    graph_.remove_vertex(second);
+    if (graph_.id(first) != graph_.npos)
+        index(first);
     deleteNode(second);
 }
 
 void DependenceGraph::simplify()
 {
     for (auto it = graph_.begin(); it != graph_.end();) {
-        unsigned int n = (NGraph::tGraph<NodeDependenceGraph*>::out_neighbors(it).size());
-        if (n == 0 && (it->first->type() == NTAffine
-                       || it->first->type() == NTProduct)) {
-            deleteNode(it->first);
-            graph_.remove_vertex(it++);
+        unsigned int n = graph_.outDegree(it.id());
+        if (n == 0 && ((*it)->type() == NTAffine
+                       || (*it)->type() == NTProduct)) {
+            NodeDependenceGraph* node = *it++;
+            remove(node);
+            deleteNode(node);
         }
         else
             it++;
@@ -177,16 +315,15 @@ void DependenceGraph::simplify()
 
 
     // remove unecessary parents
-    NGraph::tGraph<NodeDependenceGraph*>::vertex_set allParents;
+    std::set<NodeDependenceGraph*> allParents;
     list<pair<NodeDependenceGraph*, AV>> parentValuesOfNodes;
     list<AV> parentValues;
 
     for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        NodeDependenceGraph* node = it->first;
+        NodeDependenceGraph* node = *it;
         if (node->type() == NTArray) {
-            NGraph::tGraph<NodeDependenceGraph*>::vertex_set parents = graph_.in_neighbors(node);
-            for (auto inIt = parents.begin(); inIt != parents.end(); inIt++) {
-                NodeDependenceGraph *pnode = *inIt;
+            for (auto parent : graph_.inNeighbors(it.id())) {
+                NodeDependenceGraph *pnode = graph_.vertex(parent);
                 if (pnode->type() == NTAffine) {
                     allParents.insert(pnode);
                     AffineNode* anode = static_cast<AffineNode*>(pnode);
@@ -200,49 +337,62 @@ void DependenceGraph::simplify()
     } //*/
 }
 
+void DependenceGraph::prepareMessages(std::vector<unsigned int>& waitFrom, std::vector<unsigned>& ready)
+{
+    graph_.freeze();
+    waitFrom.assign(graph_.capacity(), 0);
+    ready.clear();
+    ready.reserve(graph_.size());
+    messageSymbols_.clear();
+    messageSymbols_.resize(graph_.capacity());
+    for (auto it = graph_.begin(); it != graph_.end(); it++) {
+        const auto symbols = (*it)->defineSymbols();
+        if (!symbols.empty())
+            messageSymbols_[it.id()] = std::make_unique<SymbolValue>(*symbols.begin());
+    }
+}
+
 bool DependenceGraph::spreadingTopDown()
 {
-    std::map<NodeDependenceGraph*, unsigned int> waitFrom;
-    std::queue<NodeDependenceGraph*> ready;
+    std::vector<unsigned int> waitFrom;
+    std::vector<unsigned> ready; // each node is pushed once, hence a FIFO
+    prepareMessages(waitFrom, ready);
     for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        unsigned int n = (NGraph::tGraph<NodeDependenceGraph*>::in_neighbors(it).size());
-        waitFrom[it->first] = n;
+        unsigned int n = graph_.inEdges(it.id()).size();
+        waitFrom[it.id()] = n;
         if (n == 0) {
-            ready.push(it->first);
+            ready.push_back(it.id());
         }
     }
 
-    while (!ready.empty()) {
-        NodeDependenceGraph* currentNode = ready.front();
-        ready.pop();
-        const NGraph::tGraph<NodeDependenceGraph*>::vertex_set children = graph_.out_neighbors(currentNode);
-        Range *rg = currentNode->downMessage();
-        for (auto it = children.begin(); it != children.end(); it++) {
-            auto find = labelEdges_.find(std::make_pair(currentNode, (*it)));
-            if (find != labelEdges_.end()) {
-                ParentType *from = new ParentType;
-                for (int v : find->second) {
-                    from->dim = v;
-                    (*it)->receiveDownMessage(rg, from);
+    Range message(IntegerValue(0).evaluate(), IntegerValue(0).evaluate());
+    ParentType from { 0, NULL };
+    for (std::size_t next = 0; next < ready.size(); next++) {
+        NodeDependenceGraph* currentNode = graph_.vertex(ready[next]);
+        const auto children = graph_.outEdges(ready[next]);
+        Range *rg = currentNode->downMessage(message) ? &message : NULL;
+        for (const auto& edge : children) {
+            NodeDependenceGraph* child = graph_.vertex(edge.vertex_);
+            const auto labels = graph_.labels(edge);
+            if (!labels.empty()) {
+                for (int v : labels) {
+                    from.dim = v;
+                    child->receiveDownMessage(rg, &from);
                 }
-                delete from;
             } else {
-                ParentType *from = new ParentType;
-                from->symb = std::make_unique<SymbolValue>(*(currentNode->defineSymbols().begin()));
-                (*it)->receiveDownMessage(rg, from);
-                delete from;
+                from.symb = messageSymbols_[ready[next]].get();
+                child->receiveDownMessage(rg, &from);
             }
-            if (--waitFrom[*it] == 0) {
-                ready.push(*it);
+            if (--waitFrom[edge.vertex_] == 0) {
+                ready.push_back(edge.vertex_);
             }
         }
-        delete rg;
     }
-    for (auto it = waitFrom.begin(); it != waitFrom.end(); it++) {
-        if (it->second > 0) {
+    for (auto it = graph_.begin(); it != graph_.end(); it++) {
+        if (waitFrom[it.id()] > 0) {
             std::cout << ANSI_COLOR_YELLOW
-                      << "[DependenceGraph] A " << getName(it->first->type())
-                      << " still waits for " << it->second << " of its parents."
+                      << "[DependenceGraph] A " << getName((*it)->type())
+                      << " still waits for " << waitFrom[it.id()] << " of its parents."
                       << ANSI_COLOR_RESET << std::endl;
             return false;
         }
@@ -254,27 +404,27 @@ bool DependenceGraph::spreadingBottomUp()
 {
     dg("bool DependenceGraph::spreadingBottomUp()");
 
-    std::map<NodeDependenceGraph*, unsigned int> waitFrom;
-    std::queue<NodeDependenceGraph*> ready;
+    std::vector<unsigned int> waitFrom;
+    std::vector<unsigned> ready; // each node is pushed once, hence a FIFO
+    prepareMessages(waitFrom, ready);
     for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        // it = <vertex, pair<set_of_in, set_of_out> >
-        unsigned int n = (NGraph::tGraph<NodeDependenceGraph*>::out_neighbors(it).size());
-        waitFrom[it->first] = n;
+        unsigned int n = graph_.outEdges(it.id()).size();
+        waitFrom[it.id()] = n;
         if (n == 0) {
-            ready.push(it->first);
+            ready.push_back(it.id());
         }
     }
 
-    while (!ready.empty()) {
+    Range message(IntegerValue(0).evaluate(), IntegerValue(0).evaluate());
+    ParentType to { 0, NULL };
+    for (std::size_t next = 0; next < ready.size(); next++) {
         AV afExpression; // store the expression inside the affine node
         AV size = nullptr; // value representing the size of the array
         AV minSize = IntegerValue(0).evaluate();; // value representing the size of the array
         AV slice; // length of the range of each term in a affine expression
 
-        NodeDependenceGraph* currentNode = ready.front();
-        ready.pop();
-
-        const NGraph::tGraph<NodeDependenceGraph*>::vertex_set parents = graph_.in_neighbors(currentNode);
+        NodeDependenceGraph* currentNode = graph_.vertex(ready[next]);
+        const auto parents = graph_.inEdges(ready[next]);
         IntegerValue numberOfParents(parents.size());
 
         // affine.expression = 2 + 2a & affine.range = [0, size]
@@ -304,28 +454,23 @@ bool DependenceGraph::spreadingBottomUp()
             slice = *size / numberOfParents;
         }
 
-        for (auto it = parents.begin(); it != parents.end(); it++) {
-            auto find = labelEdges_.find(std::make_pair((*it), currentNode));
-            if (find != labelEdges_.end()) {
+        for (const auto& edge : parents) {
+            NodeDependenceGraph* parent = graph_.vertex(edge.vertex_);
+            const auto labels = graph_.labels(edge);
+            if (!labels.empty()) {
                 // if the node has a label, then it is used to access some
                 // dimension in the vector
-                ParentType *to = new ParentType;
-                for (int v : find->second) {
-                    to->dim = v;
-                    Range *rg = currentNode->upMessage(to);
-                    (*it)->receiveUpMessage(rg);
-                    delete rg;
+                for (int v : labels) {
+                    to.dim = v;
+                    parent->receiveUpMessage(currentNode->upMessage(&to, message) ? &message : NULL);
                 }
-                delete to;
             } else {
                 // this other nodes have no label because they are expressions or
                 // used to build another expressions
                 if (currentNode->type() == psyche::NodeType::NTAffine) {
-                    ParentType *to = new ParentType; // add
-                    to->symb = std::make_unique<SymbolValue>(*((*it)->defineSymbols().begin())); // add
                     Range *rg; // range (msg) sended
                     //ProductNode* pnode = static_cast<ProductNode*>(*it);
-                    SymbolValue sym = (*it)->getSymbol();//(pnode->getOwnSymbol());
+                    SymbolValue sym = parent->getSymbol();//(pnode->getOwnSymbol());
                     NAryValue* n = static_cast<NAryValue*>(afExpression.get());
                     bool send = false;
 
@@ -379,40 +524,35 @@ bool DependenceGraph::spreadingBottomUp()
 
                     if (find) {
                         // if we were able to find an upper bound, we  build a range with this limit
-                        rg = new Range(minSize->clone(), msg->clone());
+                        message = Range(minSize->clone(), msg->clone());
                     }
                     else {
                         // this condition ensure that we always asign the 'rg' with something
                         r("ERROR::bool DependenceGraph::spreadingBottomUp()::not able to find a range!");
-                        rg = new Range(minSize->clone(), IntegerValue(1).clone());
+                        message = Range(minSize->clone(), IntegerValue(1).clone());
                         exit(1);
                     }
-                    (*it)->receiveUpMessage(rg);
-                    delete rg;
-                    delete to;
+                    rg = &message;
+                    parent->receiveUpMessage(rg);
                 }
                 else {
-                    ParentType *to = new ParentType;
-                    to->symb = std::make_unique<SymbolValue>(*((*it)->defineSymbols().begin()));
-                    Range *rg = currentNode->upMessage(to);
-                    (*it)->receiveUpMessage(rg);
-                    delete rg;
-                    delete to;
+                    to.symb = messageSymbols_[edge.vertex_].get();
+                    parent->receiveUpMessage(currentNode->upMessage(&to, message) ? &message : NULL);
                 }
             }
 
-            if (--waitFrom[*it] == 0) {
-                ready.push(*it);
+            if (--waitFrom[edge.vertex_] == 0) {
+                ready.push_back(edge.vertex_);
             }
         }
     }
 
     // this for below is used basically to check for problems
-    for (auto it = waitFrom.begin(); it != waitFrom.end(); it++) {
-        if (it->second > 0) {
+    for (auto it = graph_.begin(); it != graph_.end(); it++) {
+        if (waitFrom[it.id()] > 0) {
             std::cout << ANSI_COLOR_YELLOW
-                      << "[DependenceGraph] A " << getName(it->first->type())
-                      << " still waits for " << it->second << " of its children."
+                      << "[DependenceGraph] A " << getName((*it)->type())
+                      << " still waits for " << waitFrom[it.id()] << " of its children."
                       << ANSI_COLOR_RESET << std::endl;
             return false;
         }
@@ -425,12 +565,12 @@ string DependenceGraph::arraySizeVars()
 {
     std::string ret = "";
     for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        if (it->first->type() == NTArray) {
-            ArrayNode* node = static_cast<ArrayNode *>(it->first);
+        if ((*it)->type() == NTArray) {
+            ArrayNode* node = static_cast<ArrayNode *>(*it);
             ret += node->declaration(); // Declare the size as a global variable
         }
-        if (it->first->type() == NTUncompletedFunction) {
-            UncompletedFunctionNode* node = static_cast<UncompletedFunctionNode *>(it->first);
+        if ((*it)->type() == NTUncompletedFunction) {
+            UncompletedFunctionNode* node = static_cast<UncompletedFunctionNode *>(*it);
             ret += node->declaration();
         }
     }
@@ -441,12 +581,12 @@ string DependenceGraph::stubs()
 {
     std::string ret = "";
     for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        if (it->first->type() == NTUncompletedFunction) {
-            UncompletedFunctionNode* node = static_cast<UncompletedFunctionNode *>(it->first);
+        if ((*it)->type() == NTUncompletedFunction) {
+            UncompletedFunctionNode* node = static_cast<UncompletedFunctionNode *>(*it);
             ret += node->def();
         }
-        else if (it->first->type() == NTArray) {
-            ArrayNode* node = static_cast<ArrayNode *>(it->first);
+        else if ((*it)->type() == NTArray) {
+            ArrayNode* node = static_cast<ArrayNode *>(*it);
             ret += node->stubs();
         }
     }
@@ -461,33 +601,39 @@ bool contains(std::set<const CPlusPlus::Symbol *> symbSet, const CPlusPlus::Symb
     return false;
 }
 
-string DependenceGraph::initVariables()
+string DependenceGraph::initVariables(string filename, string suffix)
 {
-    // .dot graph
-    std::ofstream ofs("initGraph.dot");
+    // .dot graph, whose output is disabled unless it is wanted
+    std::ostringstream ofs;
+    if (!Artifacts::wanted())
+        ofs.setstate(std::ios::badbit);
     ofs << "strict digraph DepGraph {" << std::endl;
 
 
-    // The initialisation dependence graph
-    NGraph::tGraph<InitNode*> initGraph_;
+    // The initialisation dependence graph, its nodes live as long as it
+    DenseGraph<InitNode*> initGraph_;
+    std::deque<InitNode> initNodes;
+    auto newInitNode = [&initNodes](NodeDependenceGraph* node, InitElement elt,
+                                    const CPlusPlus::Symbol* symbol, unsigned id) {
+        initNodes.push_back(InitNode { node, elt, symbol, id });
+        return &initNodes.back();
+    };
+    // The nodes defining each symbol, in the order of the graph
+    std::unordered_map<const CPlusPlus::Symbol*, std::vector<unsigned> > definitions;
 
     // Add different vertex for each node of the dependence graph
     // valueNode -> SymbolDefinition
     for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        NGraph::tGraph<NodeDependenceGraph*>::vertex v = it->first;
+        NodeDependenceGraph* v = *it;
         if (v->isMutable()) {
             // R -> V
-            InitNode *vert = new InitNode, *vert2 = new InitNode;
-            vert->node = v;
-            vert2->node = v;
-            vert->elt = RangeDefinition;
-            vert2->elt = SymbolDefinition;
-            vert->symbol_ = v->getSymbol();
-            vert2->symbol_ = v->getSymbol();
-            vert->id_ = v->nextId_++;
-            vert2->id_ = v->id_;
-
-            initGraph_.insert_edge(vert, vert2); // R -> S
+            InitNode *vert = newInitNode(v, RangeDefinition, v->getSymbol(), v->nextId_++);
+            InitNode *vert2 = newInitNode(v, SymbolDefinition, v->getSymbol(), v->id_);
+
+            const unsigned rangeId = initGraph_.insertVertex(vert);
+            const unsigned symbolId = initGraph_.insertVertex(vert2);
+            initGraph_.insertEdge(rangeId, symbolId); // R -> S
+            definitions[vert2->symbol_].push_back(symbolId);
 
             string symStr = "no_name";
             if (vert2->symbol_)
@@ -498,11 +644,7 @@ string DependenceGraph::initVariables()
             ofs << vert2->id_ << " [color=\"green\",shape=record,label=\"{Symbol | " + symStr + "}\"];" << endl;
             ofs << vert->id_ << " -> " << vert2->id_ << ";" << endl;
         } else if (v->isArray()) {
-            InitNode *vert = new InitNode;
-            vert->node = v;
-            vert->symbol_ = v->getSymbol();
-            vert->elt = ArrayDefinition;
-            vert->id_ = v->id_;
+            InitNode *vert = newInitNode(v, ArrayDefinition, v->getSymbol(), v->id_);
 
             string symbolStr = "no_name";
             if (vert->symbol_)
@@ -511,21 +653,17 @@ string DependenceGraph::initVariables()
             // .dot graph
             ofs << vert->id_ << " [color=\"red\",shape=record,label=\"{Array | " + symbolStr + "}\"];" << endl;
 
-            NGraph::tGraph<ArrayNode*>::vertex av = static_cast<ArrayNode*>(it->first);
+            ArrayNode* av = static_cast<ArrayNode*>(v);
 
             for (auto sizeSymbol : av->sizeSymbols_) {
-                InitNode *vert1 = new InitNode, *vert2 = new InitNode;
-                vert1->node = v;
-                vert2->node = v;
-                vert1->elt = RangeSizeDefinition;
-                vert2->elt = SizeSymbolDefinition;
-                vert1->symbol_ = sizeSymbol;
-                vert2->symbol_ = sizeSymbol;
-                vert1->id_ = v->nextId_++;
-                vert2->id_ = v->nextId_++;
-
-                initGraph_.insert_edge(vert1, vert2); // Ra -> Sa
-                initGraph_.insert_edge(vert2, vert); // Sa -> A
+                InitNode *vert1 = newInitNode(v, RangeSizeDefinition, sizeSymbol, v->nextId_++);
+                InitNode *vert2 = newInitNode(v, SizeSymbolDefinition, sizeSymbol, v->nextId_++);
+
+                const unsigned rangeId = initGraph_.insertVertex(vert1);
+                const unsigned symbolId = initGraph_.insertVertex(vert2);
+                initGraph_.insertEdge(rangeId, symbolId); // Ra -> Sa
+                initGraph_.insertEdge(symbolId, initGraph_.insertVertex(vert)); // Sa -> A
+                definitions[sizeSymbol].push_back(symbolId);
 
                 string symStr = "no_name";
                 if (vert2->symbol_)
@@ -543,54 +681,61 @@ string DependenceGraph::initVariables()
     // Connect
     for (auto it = initGraph_.begin(); it != initGraph_.end(); it++) {
         // RANGE REQUIREMENT
-        if (it->first->elt == RangeDefinition && it->first->node) {
-            std::set<const CPlusPlus::Symbol *> require = it->first->node->definitionsRequiredForRange();
+        if ((*it)->elt == RangeDefinition && (*it)->node) {
+            std::set<const CPlusPlus::Symbol *> require = (*it)->node->definitionsRequiredForRange();
             // Find them
             for (auto itSymb = require.begin(); itSymb != require.end(); itSymb++) {
-                for (auto it2 = initGraph_.begin(); it2 != initGraph_.end(); it2++) {
-                    if ((it2->first->elt == SymbolDefinition || it2->first->elt == SizeSymbolDefinition) &&
-                        it2->first->symbol_ == *itSymb) { // ask if I need this symbol to define my range
-                        // V -> R
-                        initGraph_.insert_edge(it2->first, it->first);
-
-                        // .dot graph
-                        ofs << it2->first->id_ << " -> " << it->first->id_ << ";" << endl;
-                    }
+                auto defs = definitions.find(*itSymb);
+                if (defs == definitions.end())
+                    continue;
+                for (unsigned def : defs->second) {
+                    // V -> R
+                    initGraph_.insertEdge(def, it.id());
+
+                    // .dot graph
+                    ofs << initGraph_.vertex(def)->id_ << " -> " << (*it)->id_ << ";" << endl;
                 }
             }
         }
     }
     ofs << "  \n}" << std::endl;
-    ofs.close();
+    if (Artifacts::wanted()) {
+        std::string basename = filename;
+        basename.erase(basename.end()-2, basename.end());
+        Artifacts::instance().write(basename + suffix + ".initGraph.dot", ofs.str());
+    }
 
     dg(" Initialization graph ready! ");
 
-    std::string ret = "";
+    std::ostringstream ret;
     // -- Start resolution of the initialisation
     // Initialize each node's waiting counter (Top down)
     // and declare all Input variables
-    std::map<InitNode*, unsigned int> waitFrom;
-    std::queue<InitNode*> ready;
+    initGraph_.freeze();
+    std::vector<unsigned int> waitFrom(initGraph_.capacity(), 0);
+    std::queue<unsigned> ready;
     for (auto it = initGraph_.begin(); it != initGraph_.end(); it++) {
-//b(it->first->toString());
-        unsigned int n = (NGraph::tGraph<InitNode*>::in_neighbors(it).size());
-        waitFrom[it->first] = n;
+//b((*it)->toString());
+        unsigned int n = initGraph_.inEdges(it.id()).size();
+        waitFrom[it.id()] = n;
 //cout << "  " << n << endl;
         if (n == 0) {
-            ready.push(it->first);
+            ready.push(it.id());
         }
         // declare inputs
-        if (it->first->node && it->first->node->type() == NTInput &&
-            it->first->elt == SymbolDefinition) {
-            InputNode* node = static_cast<InputNode *>(it->first->node);
-            ret += node->declaration();
+        if ((*it)->node && (*it)->node->type() == NTInput &&
+            (*it)->elt == SymbolDefinition) {
+            InputNode* node = static_cast<InputNode *>((*it)->node);
+            ret << node->declaration();
         }
     }
 
     dg(" Data Structure for traverse the Initialization graph is ready! ");
 
+    std::size_t defined = 0;
     while (!ready.empty()) {
-        InitNode* currentNode = ready.front();
+        const unsigned currentId = ready.front();
+        InitNode* currentNode = initGraph_.vertex(currentId);
         ready.pop();
 
         std::string def = "";
@@ -605,17 +750,17 @@ string DependenceGraph::initVariables()
                 break;
             }
             case ArrayDefinition: {
-                NGraph::tGraph<ArrayNode*>::vertex av = static_cast<ArrayNode*>(currentNode->node);
+                ArrayNode* av = static_cast<ArrayNode*>(currentNode->node);
                 def += av->definition(currentNode->symbol_);
                 break;
             }
             case SizeSymbolDefinition: {
-                NGraph::tGraph<ArrayNode*>::vertex av = static_cast<ArrayNode*>(currentNode->node);
+                ArrayNode* av = static_cast<ArrayNode*>(currentNode->node);
                 def += av->defineSizeSymbol(currentNode->symbol_);
                 break;
             }
             case RangeSizeDefinition: {
-                NGraph::tGraph<ArrayNode*>::vertex av = static_cast<ArrayNode*>(currentNode->node);
+                ArrayNode* av = static_cast<ArrayNode*>(currentNode->node);
                 def += av->rangeDefinition(currentNode->symbol_);
                 break;
             }
@@ -625,87 +770,203 @@ string DependenceGraph::initVariables()
         }
 
         if (def != "") {
-            ret += "//\n" + def;
+            ret << "//\n" << def;
         }
         // Release children
-        auto children = initGraph_.out_neighbors(currentNode);
-        for (auto it = children.begin(); it != children.end(); it++) {
-            if (--waitFrom[*it] == 0) {
-                ready.push(*it);
+        for (const auto& edge : initGraph_.outEdges(currentId)) {
+            if (--waitFrom[edge.vertex_] == 0) {
+                ready.push(edge.vertex_);
             }
         }
-        initGraph_.remove_vertex(currentNode);
-        delete currentNode;
+        defined++;
     }
 
     dg(" Ordem de inicialização definida! ");
 
-    PSYCHE_ASSERT(initGraph_.begin() == initGraph_.end(), return "// FAIL: loop dependence\n", "Looping dep.");
-    return ret;
+    PSYCHE_ASSERT(defined == initGraph_.size(), return "// FAIL: loop dependence\n", "Looping dep.");
+    return ret.str();
 }
 
 string DependenceGraph::freeArrays()
 {
     std::string ret = "";
     for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        if (it->first->type() == NTArray) {
-            ArrayNode* node = static_cast<ArrayNode *>(it->first);
+        if ((*it)->type() == NTArray) {
+            ArrayNode* node = static_cast<ArrayNode *>(*it);
             ret += node->free();
         }
     }
     return ret;
 }
 
+string DependenceGraph::arenaBound()
+{
+    std::string ret = "0";
+    for (auto it = graph_.begin(); it != graph_.end(); it++) {
+        if ((*it)->type() == NTArray) {
+            ArrayNode* node = static_cast<ArrayNode *>(*it);
+            ret += node->arenaBound();
+        }
+    }
+    return ret;
+}
+
+bool DependenceGraph::recordable()
+{
+    for (auto it = graph_.begin(); it != graph_.end(); it++) {
+        if ((*it)->type() == NTArray && !static_cast<ArrayNode *>(*it)->recordable())
+            return false;
+    }
+    return true;
+}
+
+void DependenceGraph::corpusShapes(string& names, string& elemSizes, string& dims)
+{
+    names = elemSizes = dims = "{";
+    for (auto it = graph_.begin(); it != graph_.end(); it++) {
+        if ((*it)->type() == NTArray)
+            static_cast<ArrayNode *>(*it)->corpusShapes(names, elemSizes, dims);
+    }
+    names += "NULL}";
+    elemSizes += "0}";
+    dims += "0}";
+}
+
+// The scalars are the values of the CSV, INVALID_RAND first.
+static std::vector<string> corpusScalarNames(const std::string& csvNames)
+{
+    std::vector<string> names = { "INVALID_RAND" };
+    std::size_t start = 0, comma;
+    while ((comma = csvNames.find(", ", start)) != string::npos) {
+        names.push_back(csvNames.substr(start, comma - start));
+        start = comma + 2;
+    }
+    return names;
+}
+
+int DependenceGraph::corpusScalars()
+{
+    return corpusScalarNames(headerCSV()).size();
+}
+
+string DependenceGraph::corpusRecord()
+{
+    std::string ret = "";
+    for (const auto& name : corpusScalarNames(headerCSV()))
+        ret += "    corpus_put(&corpus, &" + name + ", sizeof(" + name + "));\n";
+    for (auto it = graph_.begin(); it != graph_.end(); it++) {
+        if ((*it)->type() == NTArray)
+            ret += static_cast<ArrayNode *>(*it)->record();
+    }
+    return ret;
+}
+
+string DependenceGraph::corpusReplay()
+{
+    std::string ret = "";
+    for (auto it = graph_.begin(); it != graph_.end(); it++) {
+        if ((*it)->type() == NTInput)
+            ret += static_cast<InputNode *>(*it)->declaration();
+    }
+    for (const auto& name : corpusScalarNames(headerCSV()))
+        ret += "    if (!corpus_get(&corpus, &" + name + ", sizeof(" + name + ")))\n"
+               "      return 2;\n";
+    for (auto it = graph_.begin(); it != graph_.end(); it++) {
+        if ((*it)->type() == NTArray)
+            ret += static_cast<ArrayNode *>(*it)->replay();
+    }
+    return ret;
+}
+
 string DependenceGraph::headerCSV()
 {
     std::string ret = "";
     for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        if (it->first->type() != NTProduct && it->first->type() != NTAffine) {
-            ret += it->first->csvName();
+        if ((*it)->type() != NTProduct && (*it)->type() != NTAffine) {
+            ret += (*it)->csvName();
+        }
+    }
+    return ret;
+}
+
+// The columns of the results, with the kind of their printf conversion.
+static std::vector<std::pair<string, char> > resultsColumns(const string& names, const string& types)
+{
+    std::vector<std::pair<string, char> > columns;
+    std::size_t name = 0, type = 0, nameEnd, typeEnd;
+    while ((nameEnd = names.find(", ", name)) != string::npos &&
+           (typeEnd = types.find(", ", type)) != string::npos) {
+        char conversion = types[typeEnd - 1];
+        char kind = conversion == 'f' || conversion == 'e' ? 'f' : conversion == 'u' ? 'u' : 'i';
+        columns.emplace_back(names.substr(name, nameEnd - name), kind);
+        name = nameEnd + 2;
+        type = typeEnd + 2;
+    }
+    return columns;
+}
+
+string DependenceGraph::resultsRow()
+{
+    std::string names = "", types = "";
+    for (auto it = graph_.begin(); it != graph_.end(); it++) {
+        if ((*it)->type() != NTProduct && (*it)->type() != NTAffine) {
+            names += (*it)->csvName();
+            types += (*it)->csvType();
         }
     }
+    std::string ret = "";
+    for (const auto& column : resultsColumns(names, types)) {
+        if (column.second == 'f')
+            ret += "    results_double(&results, " + column.first + ", 6);\n";
+        else if (column.second == 'u')
+            ret += "    results_uint(&results, " + column.first + ");\n";
+        else
+            ret += "    results_int(&results, " + column.first + ");\n";
+    }
     return ret;
 }
 
-string DependenceGraph::valuesCSV()
+string DependenceGraph::resultsKinds()
 {
-    std::string retLeft = "\"", retRight = ", ";
+    std::string names = "", types = "";
     for (auto it = graph_.begin(); it != graph_.end(); it++) {
-        if (it->first->type() != NTProduct && it->first->type() != NTAffine) {
-            retLeft += it->first->csvType();
-            retRight += it->first->csvName();
+        if ((*it)->type() != NTProduct && (*it)->type() != NTAffine) {
+            names += (*it)->csvName();
+            types += (*it)->csvType();
         }
     }
-    retLeft += "%d, %f \\n\"";
-    retRight += "INVALID_RAND, time_spent";
-    return retLeft + retRight;
+    std::string ret = "";
+    for (const auto& column : resultsColumns(names, types))
+        ret += column.second;
+    return ret;
 }
 
 void DependenceGraph::writeDotFile(string filename, string suffix)
 {
+    if (!Artifacts::wanted())
+        return;
+
     std::string basename = filename;
     basename.erase(basename.end()-2, basename.end());
     basename.append(suffix);
     basename.append(".depGraph.dot");
-    std::ofstream ofs(basename);
+    std::ostringstream ofs;
 
     ofs << "strict digraph DepGraph {" << std::endl;
+    graph_.freeze();
     for (auto it = graph_.begin(); it != graph_.end(); it++) {
-      NGraph::tGraph<NodeDependenceGraph*>::vertex v = it->first;
+      NodeDependenceGraph* v = *it;
       ofs << v->dotRepresentation() << ";\n";
-      const NGraph::tGraph<NodeDependenceGraph*>::vertex_set out = graph_.out_neighbors(it);
-      if (out.size() != 0) {
-         for (auto it2=out.begin(); it2 != out.end(); it2++) {
-             auto find = labelEdges_.find(std::make_pair(v, (*it2)));
-             if (find != labelEdges_.end()) {
-                 ofs << v->id_ << " -> " << (*it2)->id_ << "[taillabel=\"";
-                 for (int val : find->second) {
-                     ofs << val << " ";
-                 }
-                 ofs << "\"];\n";
-             } else {
-                 ofs << v->id_ << " -> " << (*it2)->id_ << ";\n";
+      for (const auto& edge : graph_.outEdges(it.id())) {
+         const auto labels = graph_.labels(edge);
+         if (!labels.empty()) {
+             ofs << v->id_ << " -> " << graph_.vertex(edge.vertex_)->id_ << "[taillabel=\"";
+             for (int val : labels) {
+                 ofs << val << " ";
              }
+             ofs << "\"];\n";
+         } else {
+             ofs << v->id_ << " -> " << graph_.vertex(edge.vertex_)->id_ << ";\n";
          }
       }
     }
@@ -713,21 +974,21 @@ void DependenceGraph::writeDotFile(string filename, string suffix)
     // Align all Affine nodes
     ofs << "subgraph { \n  rank = same;";
     for (auto it = graph_.begin(); it != graph_.end(); it++) {
-      if (it->first->type() == NTAffine)
+      if ((*it)->type() == NTAffine)
       {
-        ofs << it->first->id_ << ";";
+        ofs << (*it)->id_ << ";";
       }
     }
     ofs << "  }\n}" << std::endl;
 
-    std::cout << "[DependenceGraph] Graph dot file written in " << basename << std::endl;
-
-    ofs.close();
+    Artifacts::instance().write(basename, ofs.str());
+    if (artifactsMode == ArtifactsMode::All)
+        std::cout << "[DependenceGraph] Graph dot file written in " << basename << std::endl;
 }
 
 int DependenceGraph::size()
 {
-    return graph_.num_nodes();
+    return graph_.size();
 }
 
 string InitNode::toString()
@@ -27,8 +27,11 @@
 #ifndef PSYCHE_DEPENDENCE_GRAPH_H__
 #define PSYCHE_DEPENDENCE_GRAPH_H__
 
-#include "ngraph.hpp"
+#include "DenseGraph.h"
 #include "NodeDependenceGraph.h"
+#include "ValueTable.h"
+#include <unordered_map>
+#include <vector>
 
 namespace psyche {
 
@@ -85,15 +88,32 @@ public:
     std::string arraySizeVars();
     //! Return the stubs for each Undefined Function as a string of C code
     std::string stubs();
-    //! Return the initialisation of each variable (global and input) as a string of C code
-    std::string initVariables();
+    //! Return the initialisation of each variable (global and input) as a string of C code,
+    //! with the dot file of the initialization graph named as in writeDotFile
+    std::string initVariables(std::string filename, std::string suffix = "");
     //! Return the statements to free all arrays allocated
     std::string freeArrays();
+    //! Return the size to give to the arena of the mains, as a C expression
+    std::string arenaBound();
+
+    //! Whether the inputs of the mains can be recorded in a corpus
+    bool recordable();
+    //! Return the names, the sizes of the elements and the dimensions of the
+    //! arrays of the corpus, as NULL- (or 0-) terminated C initializers
+    void corpusShapes(std::string& names, std::string& elemSizes, std::string& dims);
+    //! Return the number of scalars of a test in the corpus
+    int corpusScalars();
+    //! Return the statements that write the inputs of a test in the corpus
+    std::string corpusRecord();
+    //! Return the statements that declare the inputs of a test from the corpus
+    std::string corpusReplay();
 
     //! Return the header of the csv file
     std::string headerCSV();
-    //! Return the line with all values for the csv file
-    std::string valuesCSV();
+    //! Return the statements that write the values of a test in the results
+    std::string resultsRow();
+    //! Return the kinds of the columns of headerCSV in the packed results
+    std::string resultsKinds();
 
     //! Write a dot file for this graph
     void writeDotFile(std::string filename, std::string suffix = "");
@@ -101,9 +121,43 @@ public:
     int size();
 
 private:
-    //! The dependance graph currently generated
-    NGraph::tGraph<NodeDependenceGraph*> graph_;
-    std::map<NGraph::tGraph<NodeDependenceGraph*>::edge, std::set<int> > labelEdges_;
+    //! Insert a node in the graph and in the indexes, unless it is there
+    unsigned insert(NodeDependenceGraph *node);
+    //! Remove a node from the graph and from the indexes, without releasing it
+    void remove(NodeDependenceGraph *node);
+    //! (Re)index a node, after its insertion or a merge into it
+    void index(NodeDependenceGraph *node);
+    void unindex(NodeDependenceGraph *node);
+    //! The nodes that are the symbol, from the oldest to the newest
+    std::vector<NodeDependenceGraph*> nodesOf(const CPlusPlus::Symbol* symb);
+    //! The oldest node equal to the given one, other than itself
+    NodeDependenceGraph* equalNode(NodeDependenceGraph *node);
+    //! Freeze the graph and size the buffers of a spreading pass
+    void prepareMessages(std::vector<unsigned int>& waitFrom, std::vector<unsigned>& ready);
+
+    //! The dependance graph currently generated, the labels of its edges are
+    //! the dimensions of the arrays they access
+    DenseGraph<NodeDependenceGraph*> graph_;
+    //! The nodes by the names of their symbols (see NodeDependenceGraph::symbols),
+    //! and the affine nodes by their formulas (see AffineNode::formulaId)
+    std::unordered_map<const CPlusPlus::Name*, std::vector<NodeDependenceGraph*> > symbolIndex_;
+    std::unordered_map<ValueTable::Id, std::vector<NodeDependenceGraph*> > formulaIndex_;
+    //! The newest node that is a symbol (see NodeDependenceGraph::is): the
+    //! arrays by the symbols they hold, the other nodes by their names
+    std::unordered_map<const CPlusPlus::Symbol*, NodeDependenceGraph*> newestBySymbol_;
+    std::unordered_map<const CPlusPlus::Name*, NodeDependenceGraph*> newestByName_;
+    //! The product nodes by their parents (see ProductNode::parents)
+    struct ParentsHash
+    {
+        std::size_t operator()(const ProductNode::Parents& parents) const
+        {
+            return std::hash<const NodeDependenceGraph*>()(parents.first) * 31
+                    + std::hash<const NodeDependenceGraph*>()(parents.second);
+        }
+    };
+    std::unordered_map<ProductNode::Parents, std::vector<NodeDependenceGraph*>, ParentsHash> productIndex_;
+    //! The symbol each node sends along its edges without label
+    std::vector<std::unique_ptr<SymbolValue> > messageSymbols_;
 
 };
 
@@ -18,6 +18,7 @@
  *****************************************************************************/
 
 #include "Dumper.h"
+#include "Artifacts.h"
 #include "ASTMatcher.h"
 #include "ASTPatternBuilder.h"
 #include "ASTVisitor.h"
@@ -28,6 +29,7 @@
 #include "Scope.h"
 #include "Symbols.h"
 #include "TranslationUnit.h"
+#include <sstream>
 
 #ifdef __GNUC__
 #  include <cxxabi.h>
@@ -39,9 +41,9 @@ void Dumper::dump(AST *ast, const std::string& fileSuffix)
 {
     std::string basename = translationUnit()->fileName();
     basename.append(fileSuffix);
-    std::ofstream ofs(basename);
-    dump(ast, fileSuffix, ofs);
-    ofs.close();
+    std::ostringstream oss;
+    dump(ast, fileSuffix, oss);
+    psyche::Artifacts::instance().write(basename, oss.str());
 }
 
 void Dumper::dump(AST *ast, const std::string &fileSuffix, std::ostream &os)
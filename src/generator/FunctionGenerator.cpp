@@ -28,6 +28,7 @@
 #include "AST.h"
 #include "Assert.h"
 #include "Debug.h"
+#include "LinearValue.h"
 #include "Lookup.h"
 #include "Scope.h"
 #include "Symbols.h"
@@ -36,11 +37,15 @@
 #include "Control.h"
 
 #include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
 
 #define VISITOR_NAME "FunctionGenerator"
 
 using namespace CPlusPlus;
 using namespace psyche;
+using namespace std;
 
 namespace psyche {
 
@@ -57,6 +62,25 @@ const std::string includeFileName = "../../headerStub.c";
 
 }
 
+namespace {
+
+//! Indent the non-empty lines of \a code one level more (the statements of
+//! a test are built for the body of the loop on the tests).
+std::string indented(const std::string& code)
+{
+    std::string ret;
+    bool lineStart = true;
+    for (char c : code) {
+        if (lineStart && c != '\n')
+            ret += "  ";
+        ret += c;
+        lineStart = c == '\n';
+    }
+    return ret;
+}
+
+} // anonymous
+
 FunctionGenerator::FunctionGenerator(TranslationUnit *unit,
                                      DependentTypesGenerator &dependentTypesGenerator)
     : ASTVisitor(unit),
@@ -102,6 +126,12 @@ bool FunctionGenerator::isVisible(const Symbol *symbol, const Scope *scopeExtern
     return false;
 }
 
+bool FunctionGenerator::ValueOrder::operator()(const std::unique_ptr<AbstractValue>& a,
+                                               const std::unique_ptr<AbstractValue>& b) const
+{
+    return a->toString() < b->toString();
+}
+
 std::string FunctionGenerator::extractId(const Name* name)
 {
     PSYCHE_ASSERT(name && name->isNameId(),
@@ -133,14 +163,20 @@ const Symbol *FunctionGenerator::findSymbol(const Name *name)
     return symb;
 }
 
-void FunctionGenerator::generate(TranslationUnitAST* ast, Namespace* global)
+void FunctionGenerator::generate(TranslationUnitAST* ast, Namespace* global,
+                                 FunctionDefinitionAST *function)
 {
-    debugVisit = false;
     currentUnit_ = translationUnit();
+    NodeDependenceGraph::resetIds();
 
     switchScope(global);
-    for (DeclarationListAST *it = ast->declaration_list; it; it = it->next)
+    for (DeclarationListAST *it = ast->declaration_list; it; it = it->next) {
+        if (function && it->value->asFunctionDefinition() && it->value != function)
+            continue;
         accept(it->value);
+        if (it->value == function)
+            break;
+    }
 }
 
 bool FunctionGenerator::visit(FunctionDefinitionAST *ast)
@@ -309,6 +345,7 @@ bool FunctionGenerator::visit(FunctionDefinitionAST *ast)
     string newFile = path + mainFileNamePrefix + fileName + "_" + funName + mainFileNameSuffix;
     outputFile.open(newFile);
     cout << "Main file written in " << newFile << endl;
+    mainFiles_.push_back(newFile);
 
     // Include the source file and the header file
     outputFile << "#include \"" << includeFileName << "\"" << endl
@@ -316,10 +353,29 @@ bool FunctionGenerator::visit(FunctionDefinitionAST *ast)
                << endl;
 
     // Array size limit
-    outputFile << "#define " << maxArraySizeCst << " " << maxArraySizeValue << endl;
-    outputFile << "#define " << minArraySizeCst << " " << minArraySizeValue << endl;
-    outputFile << "#define " << nbTestsCst << " " << nbTestsValue << endl;
-    outputFile << "#define " << nbCallCst << " 10" << endl;
+    if (sweepCap) {
+        // The sweep takes the place of the random sizes: MIN_ARRAY_SIZE << k
+        // for each k up to the cap, repeated SWEEP_REPEATS times.
+        unsigned points = 0;
+        for (unsigned long size = std::stoul(minArraySizeValue); size <= sweepCap; size *= 2)
+            points++;
+        outputFile << "#define " << maxArraySizeCst << " " << sweepCap << endl;
+        outputFile << "#define " << minArraySizeCst << " " << minArraySizeValue << endl;
+        outputFile << "#define SWEEP_REPEATS " << sweepRepeats << endl;
+        outputFile << "#define " << nbTestsCst << " (" << points << " * SWEEP_REPEATS)" << endl;
+    } else {
+        outputFile << "#define " << maxArraySizeCst << " " << maxArraySizeValue << endl;
+        outputFile << "#define " << minArraySizeCst << " " << minArraySizeValue << endl;
+        outputFile << "#define " << nbTestsCst << " "
+                   << (budgetMs > 0 || ciTarget > 0 ? nbTestsAdaptiveValue : nbTestsValue) << endl;
+    }
+    outputFile << "#define " << nbCallCst << " " << nbCalls << endl;
+    outputFile << "#define " << nbWarmupCallCst << " " << nbWarmupCalls << endl;
+    if (nbWorkers > 1)
+        outputFile << "#define NB_WORKERS " << nbWorkers << endl;
+    outputFile << "#define SEED "
+               << (mainSeed.empty() ? "((unsigned long long) time(NULL))" : mainSeed + "ULL")
+               << endl;
 
     outputFile << "// Declare array size variables" << endl
                << depGraph_.arraySizeVars() << endl;
@@ -328,55 +384,205 @@ bool FunctionGenerator::visit(FunctionDefinitionAST *ast)
     outputFile << "// Stubs" << endl
                << depGraph_.stubs() << endl;
 
-    // Main
-    outputFile << "int main(int argc, const char* argv[]) {" << endl
-               << "  srand(time(NULL));" << endl
-               << "  int savingVar;" << endl
-               << "  int currentTest;" << endl;
-
+    // The inputs of the tests may be recorded in a corpus and replayed from
+    // it, unless an array has both fixed and pointer dimensions.
+    const bool corpus = depGraph_.recordable();
+    if (!corpus)
+        std::cout << "[FunctionGenerator] The arrays of " << funName
+                  << " can't be recorded, the main has no --record/--replay" << std::endl;
+
+    // The calls of the function for a test, timed for the CSV. With a cold
+    // arena, the arrays are flushed from the caches before each call (those
+    // of the corpus when it is replayed), out of the timed part.
+    auto flush = [corpus](const std::string& indent) -> std::string {
+        if (arenaMode != ArenaMode::Cold)
+            return "";
+        if (!corpus)
+            return indent + "arena_flush_cache();\n";
+        return indent + "if (replay)\n"
+                + indent + "  corpus_flush_cache(&corpus);\n"
+                + indent + "else\n"
+                + indent + "  arena_flush_cache();\n";
+    };
+    std::string call = "";
+    // Each call is timed on its own, the warm-up ones (it_call < 0) aren't kept.
     if (generateCSV) {
-        outputFile << "  FILE *csv_result = fopen(\"" << csvFileNamePrefix << fileName << "result.csv\", \"w\" );" << endl;
-        outputFile << "  fprintf(csv_result, \"" << depGraph_.headerCSV() << "INVALID_RAND, execution time (%d calls)\\n\", " << nbCallCst << ");" << endl;
+        call += "    double call_ns[" + nbCallCst + "];\n"
+                "    struct latency latency;\n"
+                "    int it_call;\n"
+                "    for (it_call = -" + nbWarmupCallCst + "; it_call < " + nbCallCst + "; it_call++) {\n"
+                + flush("      ") +
+                "      uint64_t call_begin = now_ns();\n";
+    } else {
+        call += flush("    ");
+        if (budgetMs > 0 || ciTarget > 0)
+            call += "    uint64_t call_begin = now_ns();\n";
     }
 
-    outputFile << "  for (currentTest = 0; currentTest < " << nbTestsCst << "; currentTest++) {" << endl
-               << "    INVALID_RAND = 0;"
-               << endl
-               << depGraph_.initVariables() // construct the initialization graph, sort the things and return a string with the definitions
-               << endl;
-
-    if (generateCSV)
-        outputFile << "    clock_t begin = clock();" << endl
-                   << "    int it_call;" << endl
-                   << "    for (it_call = 0; it_call < " << nbCallCst << "; it_call++) {" << endl;
-
-    outputFile << "      if (INVALID_RAND != 1) {" << endl
-               << "        " << func->name()->asNameId()->chars()
-               << "(";
+    call += "      if (INVALID_RAND != 1) {\n";
+    call += std::string("        ") + func->name()->asNameId()->chars() + "(";
     // Arguments
     if (func->hasArguments()) {
-        outputFile << func->argumentAt(0)->name()->asNameId()->chars();
+        call += func->argumentAt(0)->name()->asNameId()->chars();
         // Scanning arguments
         for (unsigned int i = 1; i < func->argumentCount(); i++) {
-            outputFile << ", " << func->argumentAt(i)->name()->asNameId()->chars();
+            call += std::string(", ") + func->argumentAt(i)->name()->asNameId()->chars();
         }
     }
+    call += ");\n"
+            "      }\n"; // if (INVALID_RAND != 1)
 
-    outputFile << ");" << endl
-               << "      }" << endl; // if (INVALID_RAND != 1)
+    if (generateCSV)
+        call += "      uint64_t call_end = now_ns();\n"
+                "      if (it_call >= 0)\n"
+                "        call_ns[it_call] = (double) (call_end - call_begin);\n"
+                "    }\n" // for (it_call = -NB_WARMUP_CALLS; it_call ...
+                "    latency_stats(call_ns, " + nbCallCst + ", &latency);\n"
+                + depGraph_.resultsRow() +
+                "    results_uint(&results, seed);\n"
+                "    results_int(&results, currentTest);\n"
+                "    results_int(&results, INVALID_RAND);\n"
+                "    results_double(&results, latency.min, 0);\n"
+                "    results_double(&results, latency.median, 0);\n"
+                "    results_double(&results, latency.p99, 0);\n"
+                "    results_double(&results, latency.mean, 1);\n"
+                "    results_end_row(&results);\n";
+
+    // Main
+    outputFile << "int main(int argc, const char* argv[]) {" << endl;
+    if (corpus)
+        outputFile << "  // ./main [--record|--replay corpus] [seed [test]]" << endl
+                   << "  const char *record = NULL, *replay = NULL;" << endl
+                   << "  if (argc > 2 && !strcmp(argv[1], \"--record\")) {" << endl
+                   << "    record = argv[2];" << endl
+                   << "    argc -= 2;" << endl
+                   << "    argv += 2;" << endl
+                   << "  } else if (argc > 2 && !strcmp(argv[1], \"--replay\")) {" << endl
+                   << "    replay = argv[2];" << endl
+                   << "    argc -= 2;" << endl
+                   << "    argv += 2;" << endl
+                   << "  }" << endl;
+    outputFile << "  // ./main [seed [test]] replays the tests of a run, or one of them" << endl
+               << "  unsigned long long seed = argc > 1 ? strtoull(argv[1], NULL, 0) : SEED;" << endl
+               << "  int firstTest = argc > 2 ? atoi(argv[2]) : 0;" << endl
+               << "  int lastTest = argc > 2 ? firstTest + 1 : " << nbTestsCst << ";" << endl
+               << "  int savingVar;" << endl
+               << "  int currentTest;" << endl;
+
+    if (generateCSV) {
+        outputFile << "  const char *csv_path = \"" << csvFileNamePrefix << fileName << "_" << funName
+                   << (binaryResults ? "result.bin" : "result.csv") << "\";" << endl;
+        outputFile << "  FILE *csv_result = fopen(csv_path, \"w\" );" << endl;
+        if (binaryResults)
+            outputFile << "  results_header(csv_result, \"" << depGraph_.headerCSV() << "seed, test, INVALID_RAND, min (ns), median (ns), p99 (ns), mean (ns)\", \""
+                       << depGraph_.resultsKinds() << "uiiffff\");" << endl;
+        else
+            outputFile << "  fprintf(csv_result, \"" << depGraph_.headerCSV() << "seed, test, INVALID_RAND, min (ns), median (ns), p99 (ns), mean (ns, %d calls)\\n\", " << nbCallCst << ");" << endl;
+        outputFile << "  static struct results results;" << endl;
+    }
+
+    // The workers run their share of the tests, the parent gathers their CSV.
+    // A corpus is written or read by a single process.
+    if (nbWorkers > 1) {
+        outputFile << (corpus ? "  if (!record && !replay) {" : "  {") << endl
+                   << "    int status;" << endl
+                   << "    int worker = fork_workers(NB_WORKERS, &firstTest, &lastTest, &status);" << endl
+                   << "    if (worker < 0) {" << endl;
+        if (generateCSV)
+            outputFile << "      merge_shards(csv_result, csv_path, NB_WORKERS);" << endl
+                       << "      fclose(csv_result);" << endl;
+        outputFile << "      return status;" << endl
+                   << "    }" << endl;
+        if (generateCSV)
+            outputFile << "    fclose(csv_result);" << endl
+                       << "    csv_result = open_shard(csv_path, worker);" << endl;
+        outputFile << "  }" << endl;
+    }
 
     if (generateCSV)
-        outputFile << "    }" << endl // for (it_call = 0; it_call ...
-                   << "    clock_t end = clock();" << endl
-                   << "    float time_spent = ((float)(end - begin))/(float)(CLOCKS_PER_SEC);" << endl
-                   << "    fprintf(csv_result, " << depGraph_.valuesCSV() << ");" << endl;
+        outputFile << "  results_init(&results, csv_result, " << binaryResults << ");" << endl;
+    if (guardMode != GuardMode::None)
+        outputFile << "  guard_init(" << (guardMode == GuardMode::Start) << ");" << endl;
+    if (arenaMode != ArenaMode::None)
+        outputFile << "  if (!arena_init(" << depGraph_.arenaBound() << "))" << endl
+                   << "    return 2;" << endl;
+
+    if (corpus) {
+        std::string names, elemSizes, dims;
+        depGraph_.corpusShapes(names, elemSizes, dims);
+        const std::string scalars = std::to_string(depGraph_.corpusScalars());
+        outputFile << "  const char *corpus_names[] = " << names << ";" << endl
+                   << "  const int corpus_elem_sizes[] = " << elemSizes << ";" << endl
+                   << "  const int corpus_dims[] = " << dims << ";" << endl
+                   << "  struct corpus corpus;" << endl
+                   << "  if (record && !corpus_create(&corpus, record, " << scalars
+                   << ", corpus_names, corpus_elem_sizes, corpus_dims))" << endl
+                   << "    return 2;" << endl;
+
+        // The replay takes the inputs of each test in the corpus, in place.
+        outputFile << "  if (replay) {" << endl
+                   << "    if (!corpus_open(&corpus, replay, " << scalars
+                   << ", corpus_names, corpus_elem_sizes, corpus_dims))" << endl
+                   << "      return 2;" << endl
+                   << "    while (corpus_next(&corpus, &seed, &currentTest)) {" << endl;
+        if (guardMode != GuardMode::None)
+            outputFile << "      GUARD_TEST = currentTest;" << endl;
+        outputFile << indented(depGraph_.corpusReplay()) << endl
+                   << indented(call)
+                   << "      corpus_release(&corpus);" << endl
+                   << "    }" << endl
+                   << "    corpus_close(&corpus);" << endl;
+        if (generateCSV)
+            outputFile << "    results_flush(&results);" << endl
+                       << "    fclose(csv_result);" << endl;
+        outputFile << "    return 0;" << endl
+                   << "  }" << endl;
+    }
 
-    outputFile << endl
-               << depGraph_.freeArrays()
-               << "  }" << endl;
+    // The tests may stop before NB_TESTS, see stopping_done.
+    const bool adaptive = budgetMs > 0 || ciTarget > 0;
+    if (adaptive)
+        outputFile << "  struct stopping stopping;" << endl
+                   << "  stopping_init(&stopping, " << budgetMs << ", " << ciTarget << ");" << endl
+                   << "  int stop = 0;" << endl;
+
+    outputFile << "  for (currentTest = firstTest; currentTest < lastTest"
+               << (adaptive ? " && !stop" : "") << "; currentTest++) {" << endl
+               << "    rng_seed(seed, currentTest);" << endl;
+    if (guardMode != GuardMode::None)
+        outputFile << "    GUARD_TEST = currentTest;" << endl;
+    if (sweepCap)
+        outputFile << "    SWEEP_SIZE = " << minArraySizeCst << " << (currentTest / SWEEP_REPEATS);" << endl;
+    outputFile
+               << "    INVALID_RAND = 0;"
+               << endl
+               << depGraph_.initVariables(translationUnit()->fileName(), "_" + funName) // construct the initialization graph, sort the things and return a string with the definitions
+               << endl;
 
+    if (corpus)
+        outputFile << "    if (record) {" << endl
+                   << "      corpus_begin(&corpus, seed, currentTest);" << endl
+                   << indented(depGraph_.corpusRecord())
+                   << "      corpus_end(&corpus);" << endl
+                   << "    }" << endl;
+
+    outputFile << call;
+    if (adaptive)
+        outputFile << "    stop = stopping_done(&stopping, "
+                   << (generateCSV ? "latency.mean" : "(double) (now_ns() - call_begin)") << ");" << endl;
+
+    outputFile << endl
+               << depGraph_.freeArrays();
+    if (arenaMode != ArenaMode::None)
+        outputFile << "    arena_reset();" << endl;
+    outputFile << "  }" << endl;
+
+    if (corpus)
+        outputFile << "  if (record)" << endl
+                   << "    corpus_close(&corpus);" << endl;
     if (generateCSV)
-        outputFile << "  fclose(csv_result);" << endl;
+        outputFile << "  results_flush(&results);" << endl
+                   << "  fclose(csv_result);" << endl;
 
     outputFile << "  return 0;" << endl;
     outputFile << "}" << endl;
@@ -503,7 +709,7 @@ bool FunctionGenerator::visit(BinaryExpressionAST* ast)
         break;
     }
     accept(ast->left_expression);
-    std::set<std::unique_ptr<AbstractValue> > leftValues;
+    ValueSet leftValues;
     if (currentValues_.empty()) {
         PSYCHE_ASSERT(neutral, return false, "invalid left expression");
         leftValues.insert(neutral->clone());
@@ -515,7 +721,7 @@ bool FunctionGenerator::visit(BinaryExpressionAST* ast)
 
     currentValues_.clear();
     accept(ast->right_expression);
-    std::set<std::unique_ptr<AbstractValue> > rightValues;
+    ValueSet rightValues;
     if (currentValues_.empty()) {
         PSYCHE_ASSERT(neutral, return false, "invalid right expression");
         rightValues.insert(neutral->clone());
@@ -608,18 +814,10 @@ bool FunctionGenerator::visit(IdExpressionAST* ast)
         }
     }
     else if (!n) { // Looking at the variable in the range analysis result
-        Range* rg(NULL);
-        for (auto it = dependentTypesGenerator_.ra_.rangeAnalysis_[currentStatement_].begin();
-                it != dependentTypesGenerator_.ra_.rangeAnalysis_[currentStatement_].end(); ++it) {
-            if (it->first == symb) {
-                delete rg;
-                rg = new Range(it->second);
-            }
-        }
+        const Range* rg = dependentTypesGenerator_.ra_.rangeAt(currentStatement_, symb);
         PSYCHE_ASSERT(rg, return false, "local variable as no range\n");
-        addLocalVarComponents(symb, rg);
-
-        delete rg;
+        Range range(*rg);
+        addLocalVarComponents(symb, &range);
     }
     else { // Already exists
         if (n->type() == NTArray) {
@@ -790,6 +988,13 @@ void FunctionGenerator::simplifyToAffine()
 
     currentValue_.reset(currentValue_->evaluate()->develop().release());
 
+    // Most values are already affine: no node to create, just normalise them.
+    LinearValue linear;
+    if (LinearValue::fromValue(*currentValue_, linear)) {
+        currentValue_ = linear.toValue();
+        return;
+    }
+
     if (currentValue_->getKindOfValue() == KInteger) {
         terms.push_back(currentValue_->clone());
     }
@@ -853,6 +1058,8 @@ void FunctionGenerator::simplifyToAffine()
     // We have the list of terms, we can now produce the affine NAryValue
     if (!terms.empty()) {
         currentValue_.reset(new NAryValue(terms, Addition));
+        if (LinearValue::fromValue(*currentValue_, linear))
+            currentValue_ = linear.toValue();
     }
     else {
         currentValue_.reset(nullptr);
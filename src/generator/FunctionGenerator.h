@@ -37,9 +37,25 @@ class FunctionGenerator final : public CPlusPlus::ASTVisitor
 public:
     FunctionGenerator(CPlusPlus::TranslationUnit *unit,
                       DependentTypesGenerator& dependentTypesGenerator);
-    void generate(CPlusPlus::TranslationUnitAST *ast, CPlusPlus::Namespace *global);
+    //! Generate the mains of the translation unit's functions, or only the
+    //! one of \a function (knowing the declarations that precede it).
+    void generate(CPlusPlus::TranslationUnitAST *ast, CPlusPlus::Namespace *global,
+                  CPlusPlus::FunctionDefinitionAST *function = nullptr);
+
+    //! The main files written so far.
+    const std::vector<std::string>& mainFiles() const { return mainFiles_; }
 
 private:
+    //! Orders the values of an expression by their text rather than by their
+    //! addresses, so that the nodes built from them, and the main, don't
+    //! depend on where they were allocated.
+    struct ValueOrder
+    {
+        bool operator()(const std::unique_ptr<AbstractValue>& a,
+                        const std::unique_ptr<AbstractValue>& b) const;
+    };
+    using ValueSet = std::set<std::unique_ptr<AbstractValue>, ValueOrder>;
+
     std::string extractId(const CPlusPlus::Name* name);
     const CPlusPlus::Symbol* findSymbol(const CPlusPlus::Name *name);
 
@@ -103,10 +119,12 @@ private:
     std::set<NodeDependenceGraph *> currentNodes_;
     //! The AbtractValue of the current AST expression
     std::unique_ptr<AbstractValue> currentValue_;
-    std::set<std::unique_ptr<AbstractValue> > currentValues_;
+    ValueSet currentValues_;
     const CPlusPlus::StatementAST *currentStatement_;
 
     CPlusPlus::TranslationUnit *currentUnit_;
+
+    std::vector<std::string> mainFiles_;
 };
 
 }
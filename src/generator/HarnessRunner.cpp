@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+
+#include "HarnessRunner.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace psyche;
+
+namespace {
+
+const std::string mainSuffix = "_main.c";
+
+//! The executable of a main, named as testFile.sh does.
+std::string binaryOf(const std::string& main)
+{
+    if (main.size() > mainSuffix.size()
+            && main.compare(main.size() - mainSuffix.size(), mainSuffix.size(), mainSuffix) == 0) {
+        return main.substr(0, main.size() - mainSuffix.size()) + ".out";
+    }
+    return main.substr(0, main.find_last_of('.')) + ".out";
+}
+
+std::string directoryOf(const std::string& file)
+{
+    const auto slash = file.find_last_of('/');
+    return slash == std::string::npos ? "." : file.substr(0, slash);
+}
+
+std::string baseNameOf(const std::string& file)
+{
+    const auto slash = file.find_last_of('/');
+    return slash == std::string::npos ? file : file.substr(slash + 1);
+}
+
+//! The directory the mains write their results to (see FunctionGenerator).
+std::string csvDirectoryOf(const std::string& main)
+{
+    const std::string directory = directoryOf(main);
+    if (directory == ".")
+        return "../csv";
+    if (directory.find('/') == std::string::npos)
+        return "csv";
+    return directoryOf(directory) + "/csv";
+}
+
+std::string csvOf(const std::string& main)
+{
+    std::string base = baseNameOf(main);
+    if (base.size() > mainSuffix.size())
+        base.erase(base.size() - mainSuffix.size());
+    return csvDirectoryOf(main) + "/" + base + "result.csv";
+}
+
+} // anonymous
+
+HarnessRunner::HarnessRunner(unsigned int jobs, double timeoutSeconds)
+    : jobs_(jobs ? jobs : std::max(1u, std::thread::hardware_concurrency()))
+    , timeoutSeconds_(timeoutSeconds)
+{
+}
+
+int HarnessRunner::run(const std::vector<std::string>& mains,
+                       const std::string& summaryFile)
+{
+    const char* cc = std::getenv("CC");
+
+    std::vector<Process> compiles(mains.size());
+    for (std::size_t i = 0; i < mains.size(); ++i) {
+        compiles[i].argv_ = { cc && *cc ? cc : "gcc", "-g", "-Wall",
+                              mains[i], "-o", binaryOf(mains[i]) };
+        compiles[i].output_ = tmpfile();
+    }
+    runAll(compiles);
+
+    std::vector<Process> runs(mains.size());
+    for (std::size_t i = 0; i < mains.size(); ++i) {
+        // The mains write their results in ../csv, don't collect an old one.
+        mkdir(csvDirectoryOf(mains[i]).c_str(), 0755);
+        std::remove(csvOf(mains[i]).c_str());
+
+        runs[i].argv_ = { "./" + baseNameOf(binaryOf(mains[i])) };
+        runs[i].directory_ = directoryOf(mains[i]);
+        runs[i].enabled_ = WIFEXITED(compiles[i].status_)
+                && !WEXITSTATUS(compiles[i].status_);
+    }
+    runAll(runs);
+
+    std::ofstream summary(summaryFile);
+    summary << "harness,compile,run,milliseconds" << std::endl;
+
+    std::size_t width = 7;
+    for (const auto& main : mains)
+        width = std::max(width, main.size());
+    std::cout << std::endl << "Harness summary" << std::endl
+              << "  " << std::left << std::setw(width) << "Harness"
+              << "  " << std::setw(10) << "Compile"
+              << "  " << std::right << std::setw(10) << "Time (ms)"
+              << "  Run" << std::endl;
+
+    int failures = 0;
+    for (std::size_t i = 0; i < mains.size(); ++i) {
+        const std::string compile = statusString(compiles[i]);
+        const std::string run = statusString(runs[i]);
+        if (run != "ok")
+            ++failures;
+
+        if (compile != "ok" && compiles[i].output_) {
+            std::cout << "======= " << mains[i] << " =======" << std::endl;
+            rewind(compiles[i].output_);
+            char buffer[4096];
+            std::size_t n;
+            while ((n = fread(buffer, 1, sizeof(buffer), compiles[i].output_)) > 0)
+                std::cout.write(buffer, n);
+        }
+        if (compiles[i].output_)
+            fclose(compiles[i].output_);
+
+        summary << mains[i] << "," << compile << "," << run << ","
+                << std::fixed << std::setprecision(1) << runs[i].milliseconds_
+                << std::endl;
+        std::cout << "  " << std::left << std::setw(width) << mains[i]
+                  << "  " << std::setw(10) << compile
+                  << "  " << std::right << std::setw(10)
+                  << std::fixed << std::setprecision(1) << runs[i].milliseconds_
+                  << "  " << run << std::endl;
+    }
+
+    // The results follow the table, each one under the name of its CSV.
+    for (const auto& main : mains) {
+        std::ifstream csv(csvOf(main));
+        if (!csv.is_open())
+            continue;
+        summary << std::endl << "# " << csvOf(main) << std::endl
+                << csv.rdbuf();
+    }
+
+    std::cout << "  " << mains.size() - failures << "/" << mains.size()
+              << " harness(es) ran successfully, summary written in "
+              << summaryFile << std::endl;
+
+    return failures;
+}
+
+void HarnessRunner::runAll(std::vector<Process>& processes)
+{
+    std::size_t next = 0;
+    unsigned int running = 0;
+    while (true) {
+        for (; running < jobs_ && next < processes.size(); ++next) {
+            Process& process = processes[next];
+            if (!process.enabled_)
+                continue;
+            start(process);
+            if (process.pid_ > 0)
+                ++running;
+        }
+        if (!running)
+            return;
+
+        int status;
+        const pid_t pid = waitpid(-1, &status, WNOHANG);
+        const auto now = std::chrono::steady_clock::now();
+        if (pid <= 0) {
+            // Nothing finished, kill what runs for too long.
+            for (auto& process : processes) {
+                if (process.pid_ <= 0 || process.timedOut_ || timeoutSeconds_ <= 0)
+                    continue;
+                if (std::chrono::duration<double>(now - process.start_).count() > timeoutSeconds_) {
+                    kill(process.pid_, SIGKILL);
+                    process.timedOut_ = true;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
+
+        for (auto& process : processes) {
+            if (process.pid_ != pid)
+                continue;
+            process.milliseconds_ = std::chrono::duration<double, std::milli>(
+                        now - process.start_).count();
+            process.status_ = status;
+            process.pid_ = 0;
+            --running;
+        }
+    }
+}
+
+void HarnessRunner::start(Process& process)
+{
+    std::cout << std::flush;
+    process.start_ = std::chrono::steady_clock::now();
+    process.pid_ = fork();
+    if (process.pid_ < 0) {
+        process.status_ = -1;
+        return;
+    }
+    if (process.pid_ > 0)
+        return;
+
+    if (!process.directory_.empty() && chdir(process.directory_.c_str()))
+        _exit(127);
+    const int devNull = open("/dev/null", O_RDWR);
+    const int output = process.output_ ? fileno(process.output_) : devNull;
+    dup2(devNull, STDIN_FILENO);
+    dup2(output, STDOUT_FILENO);
+    dup2(output, STDERR_FILENO);
+
+    std::vector<char*> argv;
+    for (auto& arg : process.argv_)
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+    execvp(argv[0], argv.data());
+    _exit(127);
+}
+
+std::string HarnessRunner::statusString(const Process& process)
+{
+    if (!process.enabled_)
+        return "skipped";
+    if (process.status_ < 0)
+        return "fork failed";
+    if (process.timedOut_)
+        return "timeout";
+    return waitStatusString(process.status_);
+}
+
+std::string psyche::waitStatusString(int status)
+{
+    if (WIFEXITED(status)) {
+        if (!WEXITSTATUS(status))
+            return "ok";
+        return "exit " + std::to_string(WEXITSTATUS(status));
+    }
+    if (WIFSIGNALED(status))
+        return std::string("signal ") + strsignal(WTERMSIG(status));
+    return "unknown";
+}
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+#ifndef PSYCHE_HARNESSRUNNER_H__
+#define PSYCHE_HARNESSRUNNER_H__
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace psyche {
+
+/*!
+ * \brief The HarnessRunner class
+ *
+ * Compile the generated mains and run them, a bounded number of processes
+ * at once. A main that runs for longer than the timeout is killed. The
+ * status of every harness and the CSV results of the ones that wrote some
+ * are gathered into a single summary file.
+ */
+class HarnessRunner final
+{
+public:
+    //! \a jobs processes at once (0 for one per hardware thread).
+    HarnessRunner(unsigned int jobs, double timeoutSeconds);
+
+    /*!
+     * \brief run
+     * \param mains the generated main files
+     * \param summaryFile
+     * \return the number of harnesses that didn't compile or run successfully
+     */
+    int run(const std::vector<std::string>& mains, const std::string& summaryFile);
+
+private:
+    struct Process
+    {
+        std::vector<std::string> argv_;
+        //! Where the process runs (the current directory if empty).
+        std::string directory_;
+        //! Where its output goes (discarded if null).
+        FILE* output_ { nullptr };
+        //! Not started if false, e.g. because it didn't compile.
+        bool enabled_ { true };
+
+        pid_t pid_ { -1 };
+        std::chrono::steady_clock::time_point start_;
+        double milliseconds_ { 0 };
+        int status_ { 0 };
+        bool timedOut_ { false };
+    };
+
+    //! Run the processes, jobs_ at once, until all of them are done.
+    void runAll(std::vector<Process>& processes);
+    void start(Process& process);
+
+    static std::string statusString(const Process& process);
+
+    unsigned int jobs_;
+    double timeoutSeconds_;
+};
+
+/*!
+ * \brief waitStatusString
+ * \param status
+ *
+ * How a child process ended, as reported by waitpid: "ok", "exit N" or
+ * "signal NAME".
+ */
+std::string waitStatusString(int status);
+
+} // namespace psyche
+
+#endif
@@ -0,0 +1,165 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+#include "LinearValue.h"
+#include "Range.h"
+
+using namespace psyche;
+using namespace CPlusPlus;
+
+LinearValue::LinearValue(const Symbol* symbol, int64_t coefficient)
+{
+    if (coefficient)
+        terms_.push_back(Term(symbol, coefficient));
+}
+
+bool LinearValue::symbolLess(const Symbol* a, const Symbol* b)
+{
+    // Symbols are ordered as declared, so that printing a LinearValue gives
+    // the same text in every run.
+    if (a->sourceLocation() != b->sourceLocation())
+        return a->sourceLocation() < b->sourceLocation();
+    return a < b;
+}
+
+bool LinearValue::fromValue(const AbstractValue& value, LinearValue& linear)
+{
+    switch (value.getKindOfValue()) {
+    case KInteger:
+        linear = LinearValue(static_cast<const IntegerValue&>(value).getValue());
+        return true;
+
+    case KSymbol:
+        linear = LinearValue(static_cast<const SymbolValue&>(value).getSymbol());
+        return true;
+
+    case KNAry: {
+        const NAryValue& nv = static_cast<const NAryValue&>(value);
+        if (nv.op_ == Addition) {
+            linear = LinearValue();
+            for (auto& term : nv.terms_) {
+                LinearValue l;
+                if (!fromValue(*term, l) || !linear.add(l))
+                    return false;
+            }
+            return true;
+        }
+        if (nv.op_ == Multiplication) {
+            // At most one factor may depend on symbols.
+            linear = LinearValue(1);
+            bool symbolic = false;
+            int64_t factor = 1;
+            for (auto& term : nv.terms_) {
+                LinearValue l;
+                if (!fromValue(*term, l))
+                    return false;
+                if (l.isConstant()) {
+                    if (__builtin_mul_overflow(factor, l.constant_, &factor))
+                        return false;
+                } else if (symbolic) {
+                    return false;
+                } else {
+                    symbolic = true;
+                    linear = std::move(l);
+                }
+            }
+            return linear.scale(factor);
+        }
+        return false;
+    }
+
+    default:
+        return false;
+    }
+}
+
+std::unique_ptr<AbstractValue> LinearValue::toValue() const
+{
+    std::list<std::unique_ptr<AbstractValue> > terms;
+    terms.push_back(std::make_unique<IntegerValue>(constant_));
+    for (const auto& term : terms_) {
+        terms.push_back(std::make_unique<NAryValue>(
+                            std::make_unique<IntegerValue>(term.second),
+                            std::make_unique<SymbolValue>(term.first),
+                            Multiplication));
+    }
+    return std::make_unique<NAryValue>(terms, Addition);
+}
+
+int64_t LinearValue::coefficient(const Symbol* symbol) const
+{
+    for (const auto& term : terms_) {
+        if (term.first == symbol)
+            return term.second;
+    }
+    return 0;
+}
+
+bool LinearValue::add(const LinearValue& other, int64_t factor)
+{
+    int64_t value;
+    if (__builtin_mul_overflow(other.constant_, factor, &value)
+            || __builtin_add_overflow(constant_, value, &constant_)) {
+        return false;
+    }
+
+    std::vector<Term> terms;
+    terms.reserve(terms_.size() + other.terms_.size());
+    auto a = terms_.begin();
+    auto b = other.terms_.begin();
+    while (a != terms_.end() || b != other.terms_.end()) {
+        if (b == other.terms_.end()
+                || (a != terms_.end() && symbolLess(a->first, b->first))) {
+            terms.push_back(*a++);
+            continue;
+        }
+        if (__builtin_mul_overflow(b->second, factor, &value))
+            return false;
+        if (a != terms_.end() && a->first == b->first) {
+            if (__builtin_add_overflow(a->second, value, &value))
+                return false;
+            ++a;
+        }
+        if (value)
+            terms.push_back(Term(b->first, value));
+        ++b;
+    }
+    terms_.swap(terms);
+    return true;
+}
+
+bool LinearValue::scale(int64_t factor)
+{
+    if (!factor) {
+        *this = LinearValue();
+        return true;
+    }
+    if (__builtin_mul_overflow(constant_, factor, &constant_))
+        return false;
+    for (auto& term : terms_) {
+        if (__builtin_mul_overflow(term.second, factor, &term.second))
+            return false;
+    }
+    return true;
+}
+
+std::string LinearValue::toString() const
+{
+    return toValue()->toString();
+}
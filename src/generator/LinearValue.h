@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+#ifndef PSYCHE_LINEARVALUE_H__
+#define PSYCHE_LINEARVALUE_H__
+
+#include "Symbol.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace psyche {
+
+class AbstractValue;
+
+/*!
+ * \brief The LinearValue class
+ *
+ * Canonical form of an affine value: a constant plus a flat vector of
+ * (symbol, coefficient) pairs, sorted by symbol and without null
+ * coefficients. Two affine values are equal iff their linear forms are, and
+ * adding or comparing them is a merge of both vectors.
+ *
+ * This is not a kind of AbstractValue: an affine AbstractValue is turned
+ * into a LinearValue with \ref fromValue, and back with \ref toValue. The
+ * AbstractValue trees are still there for min, max and non-linear terms.
+ */
+class LinearValue final
+{
+public:
+    using Term = std::pair<const CPlusPlus::Symbol*, int64_t>;
+
+    LinearValue() = default;
+    explicit LinearValue(int64_t constant) : constant_(constant) {}
+    explicit LinearValue(const CPlusPlus::Symbol* symbol, int64_t coefficient = 1);
+
+    /*!
+     * \brief fromValue
+     *
+     * Compute the linear form of \a value into \a linear. Return false if
+     * \a value isn't affine (min, max, product of symbols, ...) or if a
+     * coefficient overflows.
+     */
+    static bool fromValue(const AbstractValue& value, LinearValue& linear);
+
+    /*!
+     * \brief toValue
+     *
+     * The affine form used by the dependence graph: c + a*x + b*y + ...
+     * (the constant is always there, even if it's 0).
+     */
+    std::unique_ptr<AbstractValue> toValue() const;
+
+    int64_t constant() const { return constant_; }
+    const std::vector<Term>& terms() const { return terms_; }
+    bool isConstant() const { return terms_.empty(); }
+
+    //! Coefficient of \a symbol (0 if absent).
+    int64_t coefficient(const CPlusPlus::Symbol* symbol) const;
+
+    /*!
+     * \brief add
+     *
+     * this += factor * other. Return false on overflow, in which case this
+     * value is left unspecified.
+     */
+    bool add(const LinearValue& other, int64_t factor = 1);
+    bool scale(int64_t factor);
+
+    bool operator==(const LinearValue& other) const
+    { return constant_ == other.constant_ && terms_ == other.terms_; }
+    bool operator!=(const LinearValue& other) const
+    { return !(*this == other); }
+
+    std::string toString() const;
+
+    //! Order of the symbols in the terms, stable from one run to another.
+    static bool symbolLess(const CPlusPlus::Symbol* a, const CPlusPlus::Symbol* b);
+
+private:
+    int64_t constant_ { 0 };
+    std::vector<Term> terms_;
+};
+
+} // namespace psyche
+
+#endif
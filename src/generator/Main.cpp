@@ -19,17 +19,29 @@
 
 
 
+#include "Artifacts.h"
 #include "Control.h"
 #include "Debug.h"
+#include "HarnessRunner.h"
 #include "Literals.h"
+#include "NodeDependenceGraph.h"
 #include "Runner.h"
 #include "Tester.h"
 #include "TranslationUnit.h"
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 using namespace CPlusPlus;
 using namespace psyche;
@@ -89,22 +101,262 @@ void runTests()
     tester.testAll();
 }
 
+/*!
+ * \brief processFile
+ * \param fileName
+ * \param jobs
+ * \param mains
+ * \return 0 if the file was analysed, 1 otherwise
+ *
+ * Generate the mains of the functions of the given file, and append their
+ * names to \a mains.
+ */
+int processFile(const std::string& fileName, unsigned int jobs,
+                std::vector<std::string>& mains)
+{
+    const std::string& source = sourceFromFile(fileName);
+    if (source.empty())
+        return 1;
+
+    StringLiteral name(fileName.c_str(), fileName.length());
+    Control control;
+    AnalysisOptions options;
+    options.flag_.handleGNUerrorFunc_ = true;
+    options.jobs_ = jobs;
+    const bool ok = analyseProgram(source, control, name, options) != nullptr;
+    mains.insert(mains.end(), options.mains_.begin(), options.mains_.end());
+
+    // The debug artifacts kept for this file are only written if it failed.
+    if (Artifacts::wanted()) {
+        if (ok)
+            Artifacts::instance().discard();
+        else
+            Artifacts::instance().fail();
+        Artifacts::instance().flush();
+    }
+    return ok ? 0 : 1;
+}
+
+/*!
+ * \brief readManifest
+ * \param fileName
+ * \param files
+ * \return false if the manifest can't be read
+ *
+ * Append the files listed in a manifest, one per line. Empty lines and lines
+ * starting with '#' are skipped.
+ */
+bool readManifest(const std::string& fileName, std::vector<std::string>& files)
+{
+    std::ifstream ifs(fileName);
+    if (!ifs.is_open()) {
+        std::cerr << "Manifest not found: " << fileName << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(ifs, line)) {
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (!line.empty() && line[0] != '#')
+            files.push_back(line);
+    }
+    return true;
+}
+
+/*!
+ * \brief The BatchJob struct
+ *
+ * A file of a batch: it's processed by a child process, whose output goes to
+ * a temporary file until it can be printed in the order of the batch. The
+ * names of the mains it writes are sent back through another one.
+ */
+struct BatchJob
+{
+    std::string fileName_;
+    pid_t pid_ { -1 };
+    FILE* log_ { nullptr };
+    FILE* mains_ { nullptr };
+    std::chrono::steady_clock::time_point start_;
+    double milliseconds_ { 0 };
+    int status_ { 0 };
+    bool done_ { false };
+};
+
+/*!
+ * \brief runBatch
+ * \param files
+ * \param jobs
+ * \param mains the mains written, in the order of the files
+ * \return the number of files that failed
+ *
+ * Process each file in its own process, \a jobs of them at once, so that a
+ * crash or an exit() in the analysis of a file doesn't stop the batch. The
+ * children are forked from this process, which spares the start-up of a
+ * Gen per file. The outputs are printed in the order of \a files, followed
+ * by a summary of the time and status of each file.
+ */
+int runBatch(const std::vector<std::string>& files, unsigned int jobs,
+             std::vector<std::string>& mains)
+{
+    if (!jobs)
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<BatchJob> batch(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i)
+        batch[i].fileName_ = files[i];
+
+    std::size_t next = 0;
+    std::size_t printed = 0;
+    unsigned int running = 0;
+    while (printed < batch.size()) {
+        while (running < jobs && next < batch.size()) {
+            BatchJob& job = batch[next++];
+            job.log_ = tmpfile();
+            job.mains_ = tmpfile();
+            job.start_ = std::chrono::steady_clock::now();
+            std::cout << std::flush;
+            job.pid_ = fork();
+            if (job.pid_ == 0) {
+                if (job.log_) {
+                    dup2(fileno(job.log_), STDOUT_FILENO);
+                    dup2(fileno(job.log_), STDERR_FILENO);
+                }
+                // Functions are analysed one after the other, the files are
+                // already spread over the cores.
+                std::vector<std::string> written;
+                const int ret = processFile(job.fileName_, 1, written);
+                if (job.mains_) {
+                    for (const auto& main : written)
+                        fprintf(job.mains_, "%s\n", main.c_str());
+                    fflush(job.mains_);
+                }
+                std::cout << std::flush;
+                std::cerr << std::flush;
+                _exit(ret);
+            }
+            if (job.pid_ < 0) {
+                job.status_ = -1;
+                job.done_ = true;
+                continue;
+            }
+            ++running;
+        }
+
+        int status;
+        const pid_t pid = running ? waitpid(-1, &status, 0) : -1;
+        for (auto& job : batch) {
+            if (pid > 0 && job.pid_ == pid && !job.done_) {
+                job.milliseconds_ = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - job.start_).count();
+                job.status_ = status;
+                job.done_ = true;
+                --running;
+            }
+        }
+
+        for (; printed < batch.size() && batch[printed].done_; ++printed) {
+            BatchJob& job = batch[printed];
+            std::cout << "======= " << job.fileName_ << " =======" << std::endl;
+            if (job.log_) {
+                rewind(job.log_);
+                char buffer[4096];
+                std::size_t n;
+                while ((n = fread(buffer, 1, sizeof(buffer), job.log_)) > 0)
+                    std::cout.write(buffer, n);
+                fclose(job.log_);
+                job.log_ = nullptr;
+            }
+            if (job.mains_) {
+                rewind(job.mains_);
+                char line[4096];
+                while (fgets(line, sizeof(line), job.mains_)) {
+                    line[strcspn(line, "\n")] = '\0';
+                    mains.push_back(line);
+                }
+                fclose(job.mains_);
+                job.mains_ = nullptr;
+            }
+        }
+    }
+
+    std::size_t width = 4;
+    for (const auto& job : batch)
+        width = std::max(width, job.fileName_.size());
+
+    int failures = 0;
+    std::cout << std::endl << "Batch summary" << std::endl
+              << "  " << std::left << std::setw(width) << "File"
+              << "  " << std::right << std::setw(10) << "Time (ms)"
+              << "  Status" << std::endl;
+    for (const auto& job : batch) {
+        const std::string status = job.status_ < 0 ? "fork failed"
+                                                   : waitStatusString(job.status_);
+        if (status != "ok")
+            ++failures;
+        std::cout << "  " << std::left << std::setw(width) << job.fileName_
+                  << "  " << std::right << std::setw(10)
+                  << std::fixed << std::setprecision(1) << job.milliseconds_
+                  << "  " << status << std::endl;
+    }
+    std::cout << "  " << batch.size() - failures << "/" << batch.size()
+              << " file(s) processed successfully" << std::endl;
+
+    return failures;
+}
+
+/*!
+ * \brief printUsage
+ */
+void printUsage()
+{
+    std::cout << "Usage:\n"
+              << "   - Run tests, only.\n"
+              << "   $ ./Gen\n\n"
+              << "   - Process a given file\n"
+              << "   $ ./Gen path/to/file.c\n\n"
+              << "   - Process many files, N at a time (one per core by default)\n"
+              << "   $ ./Gen [--jobs N] path/to/a.c path/to/b.c ...\n"
+              << "   $ ./Gen [--jobs N] --manifest path/to/list.txt\n\n"
+              << "   - Options\n"
+              << "   --loop-iterations N visits of a loop body that widen its ranges to\n"
+              << "                    thresholds, before they go to infinity (8)\n"
+              << "   --narrowing N    visits that narrow them back afterwards (1)\n"
+              << "   --csv            the mains write their results in ../csv\n"
+              << "   --binary         with --csv, packed binary results (result.bin)\n"
+              << "   --contiguous     allocate each pointer array in a single block\n"
+              << "   --arena warm|cold allocate the arrays in an arena reused by every test,\n"
+              << "                    flushed from the caches before each call if cold\n"
+              << "   --guard end|start allocate each block of the arrays against a guard page\n"
+              << "                    after its end (or before its start); the mains exit\n"
+              << "                    with 3 on an out-of-bounds access. Implies --contiguous\n"
+              << "   --seed N         default seed of the mains (the time otherwise)\n"
+              << "   --calls N        calls timed by each test of the mains (10)\n"
+              << "   --warmup N       untimed calls before them (0)\n"
+              << "   --sweep CAP      the mains sweep the array sizes the others don't\n"
+              << "                    depend on over MIN_ARRAY_SIZE, twice it, ... up to CAP\n"
+              << "   --repeats N      tests of the mains at each size of the sweep (10)\n"
+              << "   --budget-ms MS   the tests of a main stop after MS milliseconds\n"
+              << "   --ci PCT         or once the 95% confidence interval of their mean latency\n"
+              << "                    is within PCT% of it\n"
+              << "   --workers N      the mains split their tests between N processes\n"
+              << "   --run            compile and run the mains once generated\n"
+              << "   --timeout S      kill a main that runs for more than S seconds (60)\n"
+              << "   --summary FILE   where --run writes its summary (run_summary.csv)\n"
+              << "   --artifacts none|on-failure|all\n"
+              << "                    when to write the .dot files of the ASTs and of the\n"
+              << "                    graphs: never, for the files that fail (default), always\n"
+              << "   --artifacts-async write them on a background thread\n"
+              << "   --artifacts-compress gzip them"
+              << std::endl;
+}
+
 /*!
  * \brief main
  * \return
  */
 int main(int argc, char* argv[])
 {
-    if (argc > 3) {
-        std::cout << "Usage:\n"
-                  << "   - Run tests, only.\n"
-                  << "   $ ./Gen\n\n"
-                  << "   - Process a given file\n"
-                  << "   $ ./Gen path/to/file.c "
-                  << std::endl;
-        return 0;
-    }
-
     if (argc == 1) {
         try {
             runTests();
@@ -118,13 +370,135 @@ int main(int argc, char* argv[])
         return 0;
     }
 
-    const std::string& inFileName = argv[1];
-    StringLiteral name(inFileName.c_str(), inFileName.length());
-    const std::string& source = sourceFromFile(inFileName);
-    Control control;
-    AnalysisOptions options;
-    options.flag_.handleGNUerrorFunc_ = true;
-    analyseProgram(source, control, name, options);
+    std::vector<std::string> files;
+    unsigned int jobs = 0;
+    bool batch = false;
+    bool run = false;
+    double timeout = 60;
+    std::string summary = "run_summary.csv";
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--loop-iterations" && i + 1 < argc) {
+            loopIterations = std::strtoul(argv[++i], nullptr, 10);
+            if (!loopIterations) {
+                printUsage();
+                return 0;
+            }
+        } else if (arg == "--narrowing" && i + 1 < argc) {
+            narrowingPasses = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--csv") {
+            generateCSV = true;
+        } else if (arg == "--binary") {
+            binaryResults = true;
+        } else if (arg == "--contiguous") {
+            contiguousArrays = true;
+        } else if (arg == "--arena" && i + 1 < argc) {
+            const std::string mode = argv[++i];
+            if (mode != "warm" && mode != "cold") {
+                printUsage();
+                return 0;
+            }
+            arenaMode = mode == "warm" ? ArenaMode::Warm : ArenaMode::Cold;
+        } else if (arg == "--guard" && i + 1 < argc) {
+            const std::string mode = argv[++i];
+            if (mode != "end" && mode != "start") {
+                printUsage();
+                return 0;
+            }
+            guardMode = mode == "end" ? GuardMode::End : GuardMode::Start;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            char* end;
+            const std::string seed = argv[++i];
+            std::strtoull(seed.c_str(), &end, 0);
+            if (seed.empty() || *end) {
+                printUsage();
+                return 0;
+            }
+            mainSeed = seed;
+        } else if (arg == "--calls" && i + 1 < argc) {
+            nbCalls = std::strtoul(argv[++i], nullptr, 10);
+            if (!nbCalls) {
+                printUsage();
+                return 0;
+            }
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            nbWarmupCalls = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--sweep" && i + 1 < argc) {
+            sweepCap = std::strtoul(argv[++i], nullptr, 10);
+            if (sweepCap < std::stoul(minArraySizeValue) || sweepCap > INT_MAX / 2) {
+                printUsage();
+                return 0;
+            }
+        } else if (arg == "--repeats" && i + 1 < argc) {
+            sweepRepeats = std::strtoul(argv[++i], nullptr, 10);
+            if (!sweepRepeats) {
+                printUsage();
+                return 0;
+            }
+        } else if (arg == "--budget-ms" && i + 1 < argc) {
+            budgetMs = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--ci" && i + 1 < argc) {
+            ciTarget = std::strtod(argv[++i], nullptr) / 100;
+        } else if (arg == "--workers" && i + 1 < argc) {
+            nbWorkers = std::strtoul(argv[++i], nullptr, 10);
+            if (!nbWorkers) {
+                printUsage();
+                return 0;
+            }
+        } else if (arg == "--run") {
+            run = true;
+        } else if (arg == "--timeout" && i + 1 < argc) {
+            timeout = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--summary" && i + 1 < argc) {
+            summary = argv[++i];
+        } else if (arg == "--artifacts" && i + 1 < argc) {
+            const std::string mode = argv[++i];
+            if (mode != "none" && mode != "on-failure" && mode != "all") {
+                printUsage();
+                return 0;
+            }
+            artifactsMode = mode == "none" ? ArtifactsMode::None
+                          : mode == "all" ? ArtifactsMode::All : ArtifactsMode::OnFailure;
+        } else if (arg == "--artifacts-async") {
+            asyncArtifacts = true;
+        } else if (arg == "--artifacts-compress") {
+            compressArtifacts = true;
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            jobs = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--manifest" && i + 1 < argc) {
+            if (!readManifest(argv[++i], files))
+                return 1;
+            batch = true;
+        } else if (arg == "clean") {
+            // Passed by testFile.sh, it isn't a file.
+        } else if (arg.compare(0, 2, "--") == 0) {
+            printUsage();
+            return 0;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    // The guard pages replace the arena.
+    if (files.empty() || (guardMode != GuardMode::None && arenaMode != ArenaMode::None)) {
+        printUsage();
+        return 0;
+    }
+
+    // A mapping per row of the pointer arrays would go past vm.max_map_count
+    // on the 3-D ones: with guard pages, each array is a single block.
+    if (guardMode != GuardMode::None)
+        contiguousArrays = true;
+
+    std::vector<std::string> mains;
+    int ret;
+    if (batch || files.size() > 1)
+        ret = runBatch(files, jobs, mains) ? 1 : 0;
+    else
+        ret = processFile(files.front(), jobs, mains);
+
+    if (run && HarnessRunner(jobs, timeout).run(mains, summary))
+        ret = 1;
 
-    return 0;
+    return ret;
 }
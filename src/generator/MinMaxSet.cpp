@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+#include "MinMaxSet.h"
+#include "Assert.h"
+#include "ValueTable.h"
+#include <algorithm>
+
+using namespace psyche;
+
+MinMaxSet::MinMaxSet(Operation op)
+    : op_(op)
+{
+    PSYCHE_ASSERT(op == Minimum || op == Maximum, return,
+                  "MinMaxSet is either a min or a max");
+}
+
+MinMaxSet::MinMaxSet(Operation op, std::unique_ptr<AbstractValue> value)
+    : MinMaxSet(op)
+{
+    insert(std::move(value));
+}
+
+MinMaxSet::MinMaxSet(const MinMaxSet& other)
+    : op_(other.op_)
+{
+    *this = other;
+}
+
+MinMaxSet& MinMaxSet::operator=(const MinMaxSet& other)
+{
+    if (this == &other)
+        return *this;
+    op_ = other.op_;
+    terms_.clear();
+    terms_.reserve(other.terms_.size());
+    for (const auto& term : other.terms_)
+        terms_.push_back(Term { term.value_->clone(), term.linear_, term.isLinear_ });
+    return *this;
+}
+
+void MinMaxSet::insert(std::unique_ptr<AbstractValue> value)
+{
+    if (!value)
+        return;
+
+    value = value->evaluate();
+    if (value->getKindOfValue() == KNAry
+            && static_cast<NAryValue*>(value.get())->op_ == op_) {
+        for (auto& term : static_cast<NAryValue*>(value.get())->terms_)
+            insert(std::move(term));
+        return;
+    }
+
+    Term term;
+    term.isLinear_ = LinearValue::fromValue(*value, term.linear_);
+    term.value_ = std::move(value);
+
+    for (const auto& other : terms_) {
+        if (dominates(other, term))
+            return;
+    }
+    terms_.erase(std::remove_if(terms_.begin(), terms_.end(),
+                                [this, &term](const Term& other) {
+                                    return dominates(term, other);
+                                }),
+                 terms_.end());
+    terms_.push_back(std::move(term));
+}
+
+void MinMaxSet::insert(const MinMaxSet& other)
+{
+    for (const auto& term : other.terms_)
+        insert(term.value_->clone());
+}
+
+std::unique_ptr<AbstractValue> MinMaxSet::toValue() const
+{
+    if (terms_.empty())
+        return nullptr;
+    if (terms_.size() == 1)
+        return terms_.front().value_->clone();
+
+    std::list<std::unique_ptr<AbstractValue> > terms;
+    for (const auto& term : terms_)
+        terms.push_back(term.value_->clone());
+    return NAryValue(terms, op_).evaluate();
+}
+
+bool MinMaxSet::dominates(const Term& a, const Term& b) const
+{
+    // The infinity that absorbs everything, and the one that is absorbed.
+    const Sign absorbing = op_ == Maximum ? Positive : Negative;
+    if (a.value_->getKindOfValue() == KInfinity
+            && static_cast<InfinityValue*>(a.value_.get())->getSign() == absorbing) {
+        return true;
+    }
+    if (b.value_->getKindOfValue() == KInfinity
+            && static_cast<InfinityValue*>(b.value_.get())->getSign() != absorbing) {
+        return true;
+    }
+
+    if (a.isLinear_ && b.isLinear_) {
+        LinearValue diff = a.linear_;
+        if (!diff.add(b.linear_, -1) || !diff.isConstant())
+            return false;
+        return op_ == Maximum ? diff.constant() >= 0 : diff.constant() <= 0;
+    }
+
+    ValueTable& table = ValueTable::instance();
+    return table.idOf(*a.value_) == table.idOf(*b.value_);
+}
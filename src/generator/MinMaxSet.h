@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+#ifndef PSYCHE_MINMAXSET_H__
+#define PSYCHE_MINMAXSET_H__
+
+#include "LinearValue.h"
+#include "Range.h"
+#include <memory>
+#include <vector>
+
+namespace psyche {
+
+/*!
+ * \brief The MinMaxSet class
+ *
+ * The operands of a min (or max) without the ones that can't be the result.
+ * A new operand is dropped if another one is always smaller (larger for a
+ * max), and the operands it dominates are removed. Two operands are compared
+ * by the sign of the difference of their linear forms, which is only known
+ * when that difference is a constant; operands that aren't affine are only
+ * checked for duplicates.
+ *
+ * Unlike nesting NAryValues, inserting the same access many times leaves a
+ * single operand.
+ */
+class MinMaxSet final
+{
+public:
+    explicit MinMaxSet(Operation op);
+    MinMaxSet(Operation op, std::unique_ptr<AbstractValue> value);
+    MinMaxSet(const MinMaxSet&);
+    MinMaxSet(MinMaxSet&&) = default;
+    MinMaxSet& operator=(const MinMaxSet&);
+    MinMaxSet& operator=(MinMaxSet&&) = default;
+
+    //! Add an operand; a min (max) operand of a min (max) set is flattened.
+    void insert(std::unique_ptr<AbstractValue> value);
+    void insert(const MinMaxSet& other);
+
+    bool empty() const { return terms_.empty(); }
+    std::size_t size() const { return terms_.size(); }
+
+    //! The (evaluated) min or max of the operands.
+    std::unique_ptr<AbstractValue> toValue() const;
+
+private:
+    struct Term
+    {
+        std::unique_ptr<AbstractValue> value_;
+        LinearValue linear_;
+        bool isLinear_;
+    };
+
+    //! Whether \a a makes \a b useless.
+    bool dominates(const Term& a, const Term& b) const;
+
+    Operation op_;
+    std::vector<Term> terms_;
+};
+
+} // namespace psyche
+
+#endif
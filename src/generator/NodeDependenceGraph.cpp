@@ -34,7 +34,7 @@
 
 using namespace psyche;
 
-unsigned NodeDependenceGraph::nextId_ = 0;
+thread_local unsigned NodeDependenceGraph::nextId_ = 0;
 
 const std::string arrayStyle                = "color=\"#CC0000\",shape=record,";
 const std::string affineStyle               = "color=\"#0000CC\",shape=record,";
@@ -259,7 +259,7 @@ std::string ArrayNode::dotRepresentation() const
     // Accesses
     std::string accesses = "{ ";
     for (auto it = maximumAccess_.begin(); it != maximumAccess_.end(); ++it) {
-        accesses += (*it)->toString();
+        accesses += it->toValue()->toString();
         accesses += "|";
     }
     if (accesses.length() == 2) {
@@ -300,22 +300,21 @@ void ArrayNode::receiveDownMessage(Range *rg, ParentType *from)
     if (!rg)
         return;
     if (maximumAccess_.size() > from->dim - 1)
-        maximumAccess_[from->dim - 1] = NAryValue(maximumAccess_[from->dim - 1]->clone(),
-                                             rg->upper(),
-                                             Maximum).evaluate();
+        maximumAccess_[from->dim - 1].insert(rg->upper());
     else {
         while (maximumAccess_.size() < from->dim - 1) {
-            maximumAccess_.push_back(IntegerValue(0).evaluate());
+            maximumAccess_.push_back(MinMaxSet(Maximum, IntegerValue(0).evaluate()));
         }
-        maximumAccess_.push_back(rg->upper());
+        maximumAccess_.push_back(MinMaxSet(Maximum, rg->upper()));
     }
 }
 
-Range *ArrayNode::upMessage(ParentType *to)
+bool ArrayNode::upMessage(ParentType *to, Range& rg)
 {
     const CPlusPlus::Symbol *sym = sizeSymbols_.at(to->dim - 1);
-    return new Range(std::make_unique<IntegerValue>(0),
-                     std::make_unique<SymbolValue>(sym));
+    rg = Range(std::make_unique<IntegerValue>(0),
+               std::make_unique<SymbolValue>(sym));
+    return true;
 }
 
 std::string ArrayNode::declaration() const
@@ -346,7 +345,7 @@ std::string ArrayNode::rangeDefinition() const
             ret += minimumSize_[i]->toCCode();
         }
         else if (maximumAccess_.size() > i) {
-            ret += maximumAccess_[i]->toCCode();
+            ret += maximumAccess_[i].toValue()->toCCode();
         }
         else {
             ret += "0";
@@ -382,7 +381,7 @@ std::string ArrayNode::rangeDefinition(const CPlusPlus::Symbol* symbol) const
                 ret += minimumSize_[i]->toCCode();
             }
             else if (maximumAccess_.size() > i) {
-                ret += maximumAccess_[i]->toCCode();
+                ret += maximumAccess_[i].toValue()->toCCode();
             }
             else {
                 ret += minArraySizeCst;
@@ -485,64 +484,49 @@ std::string ArrayNode::definition() const
             }
 
             if (d < sizeSymbols_.size()) { // this condition will be true just if tihs is a pointer array
-                ret += "    // Allocating each dynamic dimension\n";
                 std::string indent = "    ";
                 std::string pending = "";
-                std::string indexation = "";
-                // Loop for fix dimensions
                 int index;
-                for (index = 0; index < sizeSymbols_.size(); index++) {
-                    std::string nameIndex = s->name()->asNameId()->chars();
-                    nameIndex += "_i";
-                    nameIndex += std::to_string(index);
-
-                    if (index >= d) {
-                        ret += indent;
-                        ret += s->name()->asNameId()->chars();
-                        ret += indexation;
-                        ret += " = malloc(sizeof(";
-                        ret += typeName;
-                        ret += " *) * (";
-                        ret += sizeSymbols_.at(index)->name()->asNameId()->chars();
-                        ret += " + 1));\n";
-                        ret += indent;
-                        ret += "if (!";
-                        ret += s->name()->asNameId()->chars();
-                        ret += indexation;
-                        ret += ") \n";
-                        ret += indent;
-                        ret += "  return 2;\n";
-                    }
-
-                    if (index != sizeSymbols_.size() - 1) {
-                        ret += basicForLoop(nameIndex, sizeSymbols_.at(index)->name()->asNameId()->chars(), indent);
-                        pending = indent + "}\n" + pending;
-                        indent += "  ";
-                        indexation += "[";
-                        indexation += nameIndex,
-                        indexation += "]";
+                if (contiguousArrays && d == 0) {
+                    ret += contiguousAllocation(s, typeName);
+                    indent.append(2 * (sizeSymbols_.size() - 1), ' ');
+                } else {
+                    ret += "    // Allocating each dynamic dimension\n";
+                    std::string indexation = "";
+                    // Loop for fix dimensions
+                    for (index = 0; index < sizeSymbols_.size(); index++) {
+                        std::string nameIndex = s->name()->asNameId()->chars();
+                        nameIndex += "_i";
+                        nameIndex += std::to_string(index);
+
+                        if (index >= d) {
+                            ret += indent;
+                            ret += s->name()->asNameId()->chars();
+                            ret += indexation;
+                            ret += rowAllocation(s, typeName, index + 1 == sizeSymbols_.size(),
+                                                 sizeSymbols_.at(index)->name()->asNameId()->chars());
+                            ret += indent;
+                            ret += "if (!";
+                            ret += s->name()->asNameId()->chars();
+                            ret += indexation;
+                            ret += ") \n";
+                            ret += indent;
+                            ret += "  return 2;\n";
+                        }
+
+                        if (index != sizeSymbols_.size() - 1) {
+                            ret += basicForLoop(nameIndex, sizeSymbols_.at(index)->name()->asNameId()->chars(), indent);
+                            pending = indent + "}\n" + pending;
+                            indent += "  ";
+                            indexation += "[";
+                            indexation += nameIndex,
+                            indexation += "]";
+                        }
                     }
+                    ret += pending;
                 }
-                ret += pending;
-
-                // this for below is used to initialize the allocated arrays
-                ret += "    // *** Initialization ***************************************** \n";
-                std::string accIndent = indent;
-                pending = "";
-                indexation = "";
-                std::string vetAccess = s->name()->asNameId()->chars();
-                for (index = 0; index < sizeSymbols_.size(); index++) {
-                    std::string nameIndex = s->name()->asNameId()->chars();;
-                    nameIndex += "_it";
-                    nameIndex += std::to_string(index);
-                    ret += basicForLoop(nameIndex, sizeSymbols_.at(index)->name()->asNameId()->chars(), accIndent);
-                    pending = accIndent + "}\n" + pending;
-                    vetAccess += "[" + nameIndex + "]";
-                    accIndent += indent;
-                }
-                vetAccess = accIndent + indent + vetAccess + " = rand_a_b(0, 100);\n";
-                ret += vetAccess + pending;
-                ret += "    // ************************************************************ \n";
+
+                ret += initialization(s, typeName, d);
             }
         }
     }
@@ -609,79 +593,160 @@ std::string ArrayNode::definition(const CPlusPlus::Symbol *) const
             }
 
             if (d < sizeSymbols_.size()) { // this condition will be true just if tihs is a pointer array
-                ret += "    // Allocating each dynamic dimension\n";
                 std::string indent = "    ";
                 std::string pending = "";
-                std::string indexation = "";
-                // Loop for fix dimensions
                 int index;
-                for (index = 0; index < sizeSymbols_.size(); index++) {
-                    std::string nameIndex = s->name()->asNameId()->chars();
-                    nameIndex += "_i";
-                    nameIndex += std::to_string(index);
-
-                    if (index >= d) {
-                        ret += indent;
-                        ret += s->name()->asNameId()->chars();
-                        ret += indexation;
-                        ret += " = malloc(sizeof(";
-                        ret += typeName;
-                        ret += " *) * (";
-                        ret += sizeSymbols_.at(index)->name()->asNameId()->chars();
-                        ret += " + 1));\n";
-                        ret += indent;
-                        ret += "if (!";
-                        ret += s->name()->asNameId()->chars();
-                        ret += indexation;
-                        ret += ") \n";
-                        ret += indent;
-                        ret += "  return 2;\n";
-                    }
-
-                    if (index != sizeSymbols_.size() - 1) {
-                        ret += basicForLoop(nameIndex, sizeSymbols_.at(index)->name()->asNameId()->chars(), indent);
-                        pending = indent + "}\n" + pending;
-                        indent += "  ";
-                        indexation += "[";
-                        indexation += nameIndex,
-                        indexation += "]";
+                if (contiguousArrays && d == 0) {
+                    ret += contiguousAllocation(s, typeName);
+                    indent.append(2 * (sizeSymbols_.size() - 1), ' ');
+                } else {
+                    ret += "    // Allocating each dynamic dimension\n";
+                    std::string indexation = "";
+                    // Loop for fix dimensions
+                    for (index = 0; index < sizeSymbols_.size(); index++) {
+                        std::string nameIndex = s->name()->asNameId()->chars();
+                        nameIndex += "_i";
+                        nameIndex += std::to_string(index);
+
+                        if (index >= d) {
+                            ret += indent;
+                            ret += s->name()->asNameId()->chars();
+                            ret += indexation;
+                            ret += rowAllocation(s, typeName, index + 1 == sizeSymbols_.size(),
+                                                 sizeSymbols_.at(index)->name()->asNameId()->chars());
+                            ret += indent;
+                            ret += "if (!";
+                            ret += s->name()->asNameId()->chars();
+                            ret += indexation;
+                            ret += ") \n";
+                            ret += indent;
+                            ret += "  return 2;\n";
+                        }
+
+                        if (index != sizeSymbols_.size() - 1) {
+                            ret += basicForLoop(nameIndex, sizeSymbols_.at(index)->name()->asNameId()->chars(), indent);
+                            pending = indent + "}\n" + pending;
+                            indent += "  ";
+                            indexation += "[";
+                            indexation += nameIndex,
+                            indexation += "]";
+                        }
                     }
+                    ret += pending;
                 }
-                ret += pending;
-
-                // this for below is used to initialize the allocated arrays
-                ret += "    // *** Initialization ***************************************** \n";
-                std::string accIndent = indent;
-                pending = "";
-                indexation = "";
-                std::string vetAccess = s->name()->asNameId()->chars();
-                for (index = 0; index < sizeSymbols_.size(); index++) {
-                    std::string nameIndex = s->name()->asNameId()->chars();;
-                    nameIndex += "_it";
-                    nameIndex += std::to_string(index);
-                    ret += basicForLoop(nameIndex, sizeSymbols_.at(index)->name()->asNameId()->chars(), accIndent);
-                    pending = accIndent + "}\n" + pending;
-                    vetAccess += "[" + nameIndex + "]";
-                    accIndent += indent;
-                }
-                vetAccess = accIndent + indent + vetAccess + " = rand_a_b(0, 100);\n";
-                ret += vetAccess + pending;
-                ret += "    // ************************************************************ \n";
+
+                ret += initialization(s, typeName, d);
             }
         }
     }
     return ret;
 }
 
+std::string ArrayNode::initialization(const CPlusPlus::Symbol* s,
+                                      const std::string& typeName, int fixedDims) const
+{
+    const std::string name = s->name()->asNameId()->chars();
+    std::string fill;
+    if (typeName == "int" || typeName == "float" || typeName == "double")
+        fill = "fill_" + typeName + "_range(";
+    else
+        fill = "FILL_RANGE(" + typeName + ", ";
+
+    std::string ret = "    // *** Initialization ***************************************** \n";
+    if (contiguousArrays && fixedDims == 0) {
+        // The elements follow each other, from the first one.
+        std::string count = "(size_t) 1";
+        std::string first = name;
+        for (auto size : sizeSymbols_) {
+            count += " * (";
+            count += size->name()->asNameId()->chars();
+            count += " + 1)";
+            first += "[0]";
+        }
+        ret += "    " + fill + "&" + first + ", " + count + ", 0, 100);\n";
+    } else {
+        // One fill per row of the last dimension.
+        PSYCHE_ASSERT(!sizeSymbols_.empty(), return "", "expected the sizes of a pointer array");
+        std::string indent = "    ";
+        std::string pending = "";
+        std::string row = name;
+        for (std::size_t index = 0; index + 1 < sizeSymbols_.size(); index++) {
+            std::string nameIndex = name + "_it" + std::to_string(index);
+            ret += basicForLoop(nameIndex, sizeSymbols_.at(index)->name()->asNameId()->chars(), indent);
+            pending = indent + "}\n" + pending;
+            indent += "  ";
+            row += "[" + nameIndex + "]";
+        }
+        ret += indent + fill + "&" + row + "[0], "
+                + sizeSymbols_.back()->name()->asNameId()->chars() + " + 1, 0, 100);\n";
+        ret += pending;
+    }
+    ret += "    // ************************************************************ \n";
+    return ret;
+}
+
+std::string ArrayNode::contiguousAllocation(const CPlusPlus::Symbol* s,
+                                            const std::string& typeName) const
+{
+    const std::string name = s->name()->asNameId()->chars();
+    std::string extents = "";
+    for (auto size : sizeSymbols_) {
+        if (!extents.empty())
+            extents += ", ";
+        extents += size->name()->asNameId()->chars();
+        extents += " + 1";
+    }
+
+    std::string ret = "    // Allocating all the dimensions in a single block\n";
+    ret += "    int " + name + "_extents[] = {" + extents + "};\n";
+    if (guardMode != GuardMode::None)
+        ret += "    " + name + " = guard_contiguous_alloc(sizeof(" + typeName + "), "
+                + std::to_string(sizeSymbols_.size()) + ", " + name + "_extents, \"" + name + "\");\n";
+    else
+        ret += "    " + name + (arenaMode == ArenaMode::None ? " = contiguous_alloc(sizeof("
+                                                       : " = arena_contiguous_alloc(sizeof(")
+                + typeName + "), "
+                + std::to_string(sizeSymbols_.size()) + ", " + name + "_extents);\n";
+    ret += "    if (!" + name + ") \n";
+    ret += "      return 2;\n";
+    return ret;
+}
+
+std::string ArrayNode::rowAllocation(const CPlusPlus::Symbol* s, const std::string& typeName,
+                                     bool elements, const std::string& size) const
+{
+    if (guardMode == GuardMode::None) {
+        return (arenaMode == ArenaMode::None ? " = malloc(sizeof(" : " = arena_alloc(sizeof(")
+                + typeName + " *) * (" + size + " + 1));\n";
+    }
+    // The guard page must follow the last element, the row is allocated with
+    // the exact size of its elements.
+    const std::string elemType = elements ? typeName : "void *";
+    return " = guard_alloc(sizeof(" + elemType + ") * (" + size + " + 1), _Alignof("
+            + elemType + "), \"" + s->name()->asNameId()->chars() + "\");\n";
+}
+
+bool ArrayNode::independentDimension(std::size_t dimension) const
+{
+    if (minimumSize_.size() > dimension && minimumSize_[dimension])
+        return false;
+    if (maximumAccess_.size() <= dimension)
+        return true;
+    auto lower = maximumAccess_[dimension].toValue();
+    lower->buildSymbolDependence();
+    return lower->symbolDep_.empty();
+}
+
 std::string ArrayNode::defineSizeSymbol(const CPlusPlus::Symbol* symbol) const
 {
     std::string ret = "";
-    for (auto s : sizeSymbols_) {
+    for (std::size_t index = 0; index < sizeSymbols_.size(); index++) {
+        auto s = sizeSymbols_[index];
         if (s == symbol) {
             std::string cpltNameSize = s->name()->asNameId()->chars();
             ret += "    ";
             ret += cpltNameSize;
-            ret += " = rand_a_b(";
+            ret += sweepCap && independentDimension(index) ? " = sweep_size(" : " = rand_a_b(";
             ret += cpltNameSize + lowerSuffixe;
             ret += ", ";
             ret += cpltNameSize + upperSuffixe;
@@ -868,6 +933,15 @@ std::string ArrayNode::free() const
                    type = type->asPointerType()->elementType();
                }
            }
+           // Released all at once by arena_reset().
+           if (arenaMode != ArenaMode::None)
+               continue;
+           if (contiguousArrays && d == 0) {
+               std::string name = s->name()->asNameId()->chars();
+               ret += "    if (" + name + ") \n      "
+                       + (guardMode == GuardMode::None ? "free(" : "guard_free(") + name + ");\n";
+               continue;
+           }
            std::string indent = "    ";
            std::string pending = "";
            std::string indexation = "";
@@ -887,7 +961,7 @@ std::string ArrayNode::free() const
                    newFree += indexation;
                    newFree += ") \n  ";
                    newFree += indent;
-                   newFree += "free(";
+                   newFree += guardMode == GuardMode::None ? "free(" : "guard_free(";
                    newFree += s->name()->asNameId()->chars();
                    newFree += indexation;
                    newFree += ");\n";
@@ -909,6 +983,174 @@ std::string ArrayNode::free() const
    return ret;
 }
 
+std::string ArrayNode::arenaBound() const
+{
+    std::string ret = "";
+    for (auto s : inputSymbols_) {
+        CPlusPlus::FullySpecifiedType type;
+        if (s->isArgument())
+            type = s->asArgument()->type();
+        else if (s->isDeclaration())
+            type = s->asDeclaration()->type();
+        else
+            continue;
+
+        // Only the arrays without a fixed dimension are bounded, the others
+        // are left to the spills of the arena.
+        bool fixed = false;
+        while (type->isArrayType() || type->isPointerType()) {
+            if (type->isArrayType()) {
+                type = type->asArrayType()->elementType();
+                fixed = true;
+            } else {
+                type = type->asPointerType()->elementType();
+            }
+            type.setConst(false);
+        }
+        if (fixed || sizeSymbols_.empty())
+            continue;
+
+        ret += " + arena_bound(sizeof(" + typeSpeller_->spellTypeName(type, scope_) + "), "
+                + std::to_string(sizeSymbols_.size()) + ", " + maxArraySizeCst + " + 1, "
+                + (contiguousArrays ? "1" : "0") + ")";
+    }
+    return ret;
+}
+
+std::string ArrayNode::elementType(const CPlusPlus::Symbol* s, int& fixedDims) const
+{
+    CPlusPlus::FullySpecifiedType type;
+    if (s->isArgument())
+        type = s->asArgument()->type();
+    else if (s->isDeclaration())
+        type = s->asDeclaration()->type();
+    else
+        return "";
+
+    fixedDims = 0;
+    while (type->isArrayType() || type->isPointerType()) {
+        if (type->isArrayType()) {
+            type = type->asArrayType()->elementType();
+            fixedDims++;
+        } else {
+            type = type->asPointerType()->elementType();
+        }
+        type.setConst(false);
+    }
+    return typeSpeller_->spellTypeName(type, scope_);
+}
+
+std::string ArrayNode::extents() const
+{
+    std::string ret = "{";
+    for (auto size : sizeSymbols_) {
+        if (ret.size() > 1)
+            ret += ", ";
+        ret += size->name()->asNameId()->chars();
+        ret += " + 1";
+    }
+    return ret + "}";
+}
+
+bool ArrayNode::recordable() const
+{
+    for (auto s : inputSymbols_) {
+        int d;
+        if (elementType(s, d).empty())
+            continue;
+        if (sizeSymbols_.empty() || (d != 0 && d != sizeSymbols_.size()))
+            return false;
+    }
+    return true;
+}
+
+void ArrayNode::corpusShapes(std::string& names, std::string& elemSizes, std::string& dims) const
+{
+    for (auto s : inputSymbols_) {
+        int d;
+        std::string typeName = elementType(s, d);
+        // The fixed global arrays aren't inputs of the main.
+        if (typeName.empty() || (d != 0 && !s->isArgument()))
+            continue;
+        names += std::string("\"") + s->name()->asNameId()->chars() + "\", ";
+        elemSizes += "sizeof(" + typeName + "), ";
+        dims += std::to_string(sizeSymbols_.size()) + ", ";
+    }
+}
+
+std::string ArrayNode::record() const
+{
+    std::string ret = "";
+    for (auto s : inputSymbols_) {
+        int d;
+        std::string typeName = elementType(s, d);
+        if (typeName.empty() || (d != 0 && !s->isArgument()))
+            continue;
+
+        const std::string name = s->name()->asNameId()->chars();
+        ret += "    int " + name + "_shape[] = " + extents() + ";\n";
+        ret += "    corpus_put_shape(&corpus, " + std::to_string(sizeSymbols_.size())
+                + ", " + name + "_shape);\n";
+        if (d != 0 || contiguousArrays) {
+            // The elements follow each other, from the first one.
+            std::string first = name;
+            std::string count = "(size_t) 1";
+            for (auto size : sizeSymbols_) {
+                first += "[0]";
+                count += std::string(" * (") + size->name()->asNameId()->chars() + " + 1)";
+            }
+            ret += "    corpus_put(&corpus, &" + first + ", sizeof(" + typeName + ") * " + count + ");\n";
+            continue;
+        }
+        // One row of the last dimension at a time.
+        PSYCHE_ASSERT(!sizeSymbols_.empty(), return ret, "expected the sizes of a pointer array");
+        std::string indent = "    ";
+        std::string pending = "";
+        std::string row = name;
+        for (std::size_t index = 0; index + 1 < sizeSymbols_.size(); index++) {
+            std::string nameIndex = name + "_r" + std::to_string(index);
+            ret += basicForLoop(nameIndex, sizeSymbols_.at(index)->name()->asNameId()->chars(), indent);
+            pending = indent + "}\n" + pending;
+            indent += "  ";
+            row += "[" + nameIndex + "]";
+        }
+        ret += indent + "corpus_put(&corpus, &" + row + "[0], sizeof(" + typeName + ") * ("
+                + sizeSymbols_.back()->name()->asNameId()->chars() + " + 1));\n";
+        ret += pending;
+    }
+    return ret;
+}
+
+std::string ArrayNode::replay() const
+{
+    std::string ret = "";
+    for (auto s : inputSymbols_) {
+        int d;
+        std::string typeName = elementType(s, d);
+        if (typeName.empty() || (d != 0 && !s->isArgument()))
+            continue;
+
+        const std::string name = s->name()->asNameId()->chars();
+        const std::string dims = std::to_string(sizeSymbols_.size());
+        ret += "    ";
+        if (d == 0) {
+            if (s->isArgument())
+                ret += typeName + " " + std::string(sizeSymbols_.size(), '*') + " ";
+            ret += name + " = corpus_array(&corpus, sizeof(" + typeName + "), " + dims + ", 1);\n";
+        } else {
+            // A pointer to the rows of the fixed array, as it decays when passed.
+            ret += typeName + " (*" + name + ")";
+            for (std::size_t index = 1; index < sizeSymbols_.size(); index++)
+                ret += std::string("[") + sizeSymbols_.at(index)->name()->asNameId()->chars() + " + 1]";
+            ret += " = corpus_array(&corpus, sizeof(" + typeName + "), " + dims + ", 0);\n";
+        }
+        // A record that doesn't match the arrays stops the replay.
+        ret += "    if (!" + name + ")\n"
+               "      return 2;\n";
+    }
+    return ret;
+}
+
 void ArrayNode::merge(NodeDependenceGraph &node)
 {
     if (node.type() == type()) {
@@ -939,13 +1181,11 @@ void ArrayNode::merge(const ArrayNode &a)
     }
     int commonSize = std::min(maximumAccess_.size(), a.maximumAccess_.size());
     for (unsigned i = 0; i < commonSize; i++) {
-        maximumAccess_[i] = NAryValue(maximumAccess_[i]->clone(),
-                                      a.maximumAccess_[i]->clone(),
-                                      Maximum).evaluate();
+        maximumAccess_[i].insert(a.maximumAccess_[i]);
     }
     if (maximumAccess_.size() < a.maximumAccess_.size()) {
         for (unsigned i = commonSize; i < a.maximumAccess_.size(); i++) {
-            maximumAccess_.push_back(a.maximumAccess_[i]->clone());
+            maximumAccess_.push_back(a.maximumAccess_[i]);
         }
     }
     commonSize = std::min(minimumSize_.size(), a.minimumSize_.size());
@@ -1006,6 +1246,14 @@ bool ArrayNode::is(const CPlusPlus::Symbol* s)
     return false;
 }
 
+std::set<const CPlusPlus::Symbol *> ArrayNode::symbols() const
+{
+    std::set<const CPlusPlus::Symbol *> symbs(inputSymbols_);
+    symbs.insert(localSymbols_.begin(), localSymbols_.end());
+    symbs.insert(functions_.begin(), functions_.end());
+    return symbs;
+}
+
 const CPlusPlus::Symbol *ArrayNode::getSymbol()
 {
     return arraySymbol_;
@@ -1013,12 +1261,14 @@ const CPlusPlus::Symbol *ArrayNode::getSymbol()
 
 // -- ExpressionNode --
 
-Range *ExpressionNode::downMessage()
+bool ExpressionNode::downMessage(Range& rg)
 {
-    if (rangePostDesc_ && !receiveFree_)
-        return new Range(rangePostDesc_->lower(), rangePostDesc_->upper());
+    if (rangePostDesc_ && !receiveFree_) {
+        rg = *rangePostDesc_;
+        return true;
+    }
     else
-        return NULL;
+        return false;
 }
 
 std::set<const CPlusPlus::Symbol *> ExpressionNode::definitionsRequiredForRange() const
@@ -1106,7 +1356,7 @@ void AffineNode::receiveDownMessage(Range *rg, ParentType *from)
             AV back = terms.back()->clone();
             IntegerValue *factor = static_cast<IntegerValue *>(front.get());
             SymbolValue *symb = static_cast<SymbolValue *>(back.get());
-            if (*symb == *from->symb->clone().get()) {
+            if (*symb == *from->symb) {
                 if (*factor < zero) {
                     rangePostDesc_ = new Range(*(rangePostDesc_->lower()) +
                                                *(*(rg->upper()) * *(factor->clone())),
@@ -1123,7 +1373,7 @@ void AffineNode::receiveDownMessage(Range *rg, ParentType *from)
     }
 }
 
-Range *AffineNode::upMessage(ParentType *to)
+bool AffineNode::upMessage(ParentType *to, Range& rg)
 {
     // Coping with simple case
     std::list<std::unique_ptr<AbstractValue> > terms = formula_->termsClone();
@@ -1133,18 +1383,17 @@ Range *AffineNode::upMessage(ParentType *to)
         std::list<std::unique_ptr<AbstractValue> > term = terms.back()->termsClone();
         AV i2 = term.front()->clone();
         IntegerValue *factor = static_cast<IntegerValue *>(i2.get());
-        Range *send(NULL);
         IntegerValue zero(0);
         if (*factor < zero) {
-            send = new Range(*(*(rangePostAsc_->upper())  - *cst) / *(factor->clone()),*(*(rangePostAsc_->lower())  - *cst) / *(factor->clone()));
+            rg = Range(*(*(rangePostAsc_->upper())  - *cst) / *(factor->clone()),*(*(rangePostAsc_->lower())  - *cst) / *(factor->clone()));
         } else {
-            send = new Range(*(*(rangePostAsc_->lower())  - *cst) / *(factor->clone()),*(*(rangePostAsc_->upper())  - *cst) / *(factor->clone()));
+            rg = Range(*(*(rangePostAsc_->lower())  - *cst) / *(factor->clone()),*(*(rangePostAsc_->upper())  - *cst) / *(factor->clone()));
         }
 
-        return send;
+        return true;
     }
 
-    return NULL;
+    return false;
 }
 
 void AffineNode::receiveUpMessage(Range *rg)
@@ -1253,6 +1502,11 @@ std::unique_ptr<AbstractValue> AffineNode::getFormula()
     return formula_->clone();
 }
 
+ValueTable::Id AffineNode::formulaId() const
+{
+    return ValueTable::instance().idOf(*formula_->evaluate(), true);
+}
+
 bool AffineNode::operator==(const ExpressionNode &node) const
 {
     if (node.type() == type()) {
@@ -1358,12 +1612,13 @@ void ProductNode::receiveDownMessage(Range *rg, ParentType *from)
         receiveFree_ = true;
 }
 
-Range *ProductNode::upMessage(ParentType *to)
+bool ProductNode::upMessage(ParentType *to, Range& rg)
 {
     Range range(getRangePostAsc());
     AV size = UnaryValue(range.upper(), SquareRoot).evaluate();
 
-    return new Range(IntegerValue(1).evaluate(), move(size));
+    rg = Range(IntegerValue(1).evaluate(), move(size));
+    return true;
 }
 
 void ProductNode::receiveUpMessage(Range *rg)
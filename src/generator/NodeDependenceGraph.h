@@ -30,8 +30,12 @@
 #include "ASTVisitor.h"
 #include "Range.h"
 #include "Literals.h"
+#include "MinMaxSet.h"
 #include "TypeNameSpeller.h"
+#include "ValueTable.h"
 
+#include <algorithm>
+#include <functional>
 #include <map>
 
 namespace psyche {
@@ -45,7 +49,10 @@ const std::string maxArraySizeCst = "MAX_ARRAY_SIZE";
 const std::string maxArraySizeValue = "500";
 const std::string nbTestsCst = "NB_TESTS";
 const std::string nbTestsValue = "2000";
+//! Bound of the tests when they stop by themselves (--budget-ms, --ci)
+const std::string nbTestsAdaptiveValue = "1000000";
 const std::string nbCallCst = "NB_CALLS";
+const std::string nbWarmupCallCst = "NB_WARMUP_CALLS";
 
 class DependenceGraph;
 
@@ -62,7 +69,8 @@ class UncompletedFunctionNode;
 
 struct ParentType {
     int dim;
-    std::unique_ptr<SymbolValue> symb;
+    //! Symbol of the parent, owned by the graph
+    SymbolValue* symb;
 };
 
 enum NodeType {NTArray, NTAffine, NTProduct, NTGlobalVar, NTInput, NTUncompletedFunction};
@@ -87,9 +95,13 @@ public:
     virtual NodeType type() const = 0;
     virtual std::string dotRepresentation() const = 0;
 
-    virtual Range *downMessage() { return NULL; }
+    //! Write the range sent to the children in \a rg
+    //! \return False if there is none (the children are free)
+    virtual bool downMessage(Range& rg) { return false; }
     virtual void receiveDownMessage(Range *rg, ParentType *from) { return; }
-    virtual Range *upMessage(ParentType *to) { return NULL; }
+    //! Write the range sent to the parent \a to in \a rg
+    //! \return False if there is none
+    virtual bool upMessage(ParentType *to, Range& rg) { return false; }
     virtual void receiveUpMessage(Range *rg) { return; }
 
     virtual std::string declaration() const = 0;
@@ -136,6 +148,9 @@ public:
     virtual bool operator==(const InputNode&) const {return false;}
     virtual bool operator==(const UncompletedFunctionNode&) const {return false;}
     virtual bool is(const CPlusPlus::Symbol*) {return false;}
+    //! The symbols \ref is recognizes (by their names, or exactly for arrays)
+    virtual std::set<const CPlusPlus::Symbol *> symbols() const
+        { return std::set<const CPlusPlus::Symbol *>(); }
 
     friend class DependenceGraph;
 
@@ -143,7 +158,10 @@ public:
     virtual bool isMutable() { return false; }
     virtual bool isArray() { return false; }
 
-    static unsigned nextId_;
+    //! Ids (hence the names of the sizes) are counted per thread, restart
+    //! them for every function so that its main doesn't depend on the others.
+    static void resetIds() { nextId_ = 0; }
+    static thread_local unsigned nextId_;
 protected:
     unsigned id_;
 
@@ -172,7 +190,7 @@ public:
     void minimumSizeCstrt(int dimension, std::unique_ptr<AbstractValue> val);
 
     void receiveDownMessage(Range *rg, ParentType *from) override;
-    Range *upMessage(ParentType *to) override;
+    bool upMessage(ParentType *to, Range& rg) override;
 
     //! Only declare the sizeSymbol
     std::string declaration() const override;
@@ -193,6 +211,20 @@ public:
     std::set<const CPlusPlus::Symbol *> defineSymbols() const override;
     std::string stubs() const;
     std::string free() const;
+    //! Upper bound of the bytes the input arrays take in the arena, as a C
+    //! expression starting with " + " (empty if there is none).
+    std::string arenaBound() const;
+
+    //! Whether the input arrays can be recorded in a corpus: all their
+    //! dimensions are pointers, or all of them are fixed.
+    bool recordable() const;
+    //! Append the name, the size of the elements and the dimensions of each
+    //! input array to the C initializers of the corpus shapes.
+    void corpusShapes(std::string& names, std::string& elemSizes, std::string& dims) const;
+    //! Write the extents and the elements of the input arrays in the corpus.
+    std::string record() const;
+    //! Declare the input arrays on their elements in the corpus.
+    std::string replay() const;
 
     void merge(NodeDependenceGraph&) override;
     void merge(const ArrayNode&) override;
@@ -200,11 +232,33 @@ public:
     bool operator==(const NodeDependenceGraph&) const override;
     bool operator==(const ArrayNode&) const override;
     bool is(const CPlusPlus::Symbol*) override;
+    std::set<const CPlusPlus::Symbol *> symbols() const override;
 
     const CPlusPlus::Symbol* getSymbol() override;
     bool isArray() override { return true; }
 
 private:
+    //! Fill the elements of the array \a s with random values, see
+    //! FILL_RANGE in headerStub.c.
+    std::string initialization(const CPlusPlus::Symbol* s,
+                               const std::string& typeName, int fixedDims) const;
+    //! Alloc memory to the pointer array \a s in a single block, see
+    //! contiguous_alloc in headerStub.c.
+    std::string contiguousAllocation(const CPlusPlus::Symbol* s,
+                                     const std::string& typeName) const;
+    //! Alloc memory to a row of the pointer array \a s, of \a size + 1
+    //! pointers, or of elements if it's the last dimension.
+    std::string rowAllocation(const CPlusPlus::Symbol* s, const std::string& typeName,
+                              bool elements, const std::string& size) const;
+    //! Spell the type of the elements of the array \a s, with its number of
+    //! fixed dimensions in \a fixedDims (empty if \a s isn't an input).
+    std::string elementType(const CPlusPlus::Symbol* s, int& fixedDims) const;
+    //! The extents of the array, as a C initializer.
+    std::string extents() const;
+    //! Whether the size of the \a dimension depends on no other symbol,
+    //! so that --sweep may choose it, see sweep_size in headerStub.c.
+    bool independentDimension(std::size_t dimension) const;
+
     //! Set of input array symbols that shares the same constraints
     std::set <const CPlusPlus::Symbol *> inputSymbols_;
     //! Set of local array symbols that shares the same constraints
@@ -213,7 +267,7 @@ private:
     //! Function symbols
     std::set <const CPlusPlus::Symbol *> functions_;
     //! Maximum value that access each dimension
-    std::vector<std::unique_ptr<AbstractValue> > maximumAccess_;
+    std::vector<MinMaxSet> maximumAccess_;
     //! \brief Minimal size affected to each dimension
     //!
     //! The dimensions of the array fix with a declaration.
@@ -253,7 +307,7 @@ public:
     ~ExpressionNode()
         {delete rangePostDesc_; delete rangePostAsc_;}
 
-    Range *downMessage() override;
+    bool downMessage(Range& rg) override;
 
     std::set<const CPlusPlus::Symbol *> definitionsRequiredForRange() const override;
 
@@ -281,7 +335,7 @@ public:
     std::string dotRepresentation() const override;
 
     void receiveDownMessage(Range *rg, ParentType *from) override;
-    Range *upMessage(ParentType *to) override;
+    bool upMessage(ParentType *to, Range& rg) override;
     void receiveUpMessage(Range *rg) override;
 
     std::string declaration() const override
@@ -295,9 +349,11 @@ public:
 
     bool operator==(const NodeDependenceGraph&) const override;
     bool operator==(const ExpressionNode&) const override;
-    bool operator==(const AffineNode& e) const override { return *formula_->clone()->evaluate() == *(e.formula_->clone()->evaluate());}
+    bool operator==(const AffineNode& e) const override { return *formula_->evaluate() == *(e.formula_->evaluate());}
 
     std::unique_ptr<AbstractValue> getFormula();
+    //! Id of the evaluated formula, the same for any two equal nodes
+    ValueTable::Id formulaId() const;
 
 private:
     std::unique_ptr<AbstractValue> formula_;
@@ -320,7 +376,7 @@ public:
     std::string dotRepresentation() const override;
 
     void receiveDownMessage(Range *rg, ParentType *from) override;
-    Range *upMessage(ParentType *to) override;
+    bool upMessage(ParentType *to, Range& rg) override;
     void receiveUpMessage(Range *rg) override;
 
     std::string declaration() const override;
@@ -338,6 +394,13 @@ public:
         { return   ((*leftParent_ == *(e.leftParent_)) && (*rightParent_ == *(e.rightParent_)))
                 || ((*leftParent_ == *(e.rightParent_)) && (*rightParent_ == *(e.leftParent_)));}
     bool is(const CPlusPlus::Symbol* s) override {return ownSymbol_->name() == s->name();}
+    std::set<const CPlusPlus::Symbol *> symbols() const override { return { ownSymbol_ }; }
+
+    //! The parents, in the same order whichever is the left one (products
+    //! are equal if they have the same parents)
+    using Parents = std::pair<const NodeDependenceGraph*, const NodeDependenceGraph*>;
+    Parents parents() const
+        { return std::minmax(leftParent_, rightParent_, std::less<const NodeDependenceGraph*>()); }
 
     const CPlusPlus::Symbol* getSymbol() override;
 
@@ -376,6 +439,7 @@ public:
     std::set<const CPlusPlus::Symbol *> defineSymbols() const override;
 
     bool is(const CPlusPlus::Symbol* s) override { return symbol_->name() == s->name(); }
+    std::set<const CPlusPlus::Symbol *> symbols() const override { return { symbol_ }; }
 
     const CPlusPlus::Symbol* getSymbol() override;
     bool isMutable() override { return true; }
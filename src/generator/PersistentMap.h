@@ -0,0 +1,374 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+#ifndef PSYCHE_PERSISTENTMAP_H__
+#define PSYCHE_PERSISTENTMAP_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace psyche {
+
+/*!
+ * \brief The PersistentMap class
+ *
+ * An immutable hash-array-mapped trie. Inserting a key does not modify the
+ * map, it returns a new one that shares every untouched node with the
+ * original (path copying). Copying a map is copying its root pointer.
+ *
+ * Since there's no removal, the shape of the trie depends only on the set of
+ * keys it holds, so two maps derived from a common ancestor can be compared
+ * by walking both tries together and skipping the shared subtries (see
+ * \ref diff).
+ */
+template <class KeyT, class ValueT, class HashT = std::hash<KeyT> >
+class PersistentMap
+{
+public:
+    using value_type = std::pair<const KeyT, ValueT>;
+
+private:
+    static constexpr unsigned kBits = 5;
+    static constexpr unsigned kMask = (1u << kBits) - 1;
+
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    /*
+     * A node is either a leaf, holding the entries whose keys have the same
+     * (full) hash, or a branch, holding up to 32 children indexed by the
+     * next kBits of the hash.
+     */
+    struct Node
+    {
+        bool isLeaf() const { return !entries_.empty(); }
+
+        std::size_t hash_ { 0 };
+        std::vector<value_type> entries_;
+        uint32_t bitmap_ { 0 };
+        std::vector<NodePtr> children_;
+    };
+
+public:
+    class const_iterator
+    {
+    public:
+        const_iterator() = default;
+
+        const value_type& operator*() const { return leaf_->entries_[entry_]; }
+        const value_type* operator->() const { return &leaf_->entries_[entry_]; }
+
+        const_iterator& operator++()
+        {
+            if (++entry_ < leaf_->entries_.size())
+                return *this;
+            entry_ = 0;
+            leaf_ = nullptr;
+            advance();
+            return *this;
+        }
+
+        bool operator==(const const_iterator& other) const
+        { return leaf_ == other.leaf_ && entry_ == other.entry_; }
+        bool operator!=(const const_iterator& other) const
+        { return !(*this == other); }
+
+    private:
+        friend class PersistentMap;
+
+        explicit const_iterator(const Node* root)
+        {
+            if (root)
+                stack_.push_back(std::make_pair(root, 0));
+            advance();
+        }
+
+        const_iterator(const Node* leaf, std::size_t entry)
+            : leaf_(leaf), entry_(entry)
+        {}
+
+        // Depth-first walk until the next leaf.
+        void advance()
+        {
+            while (!stack_.empty()) {
+                auto& top = stack_.back();
+                if (top.first->isLeaf()) {
+                    leaf_ = top.first;
+                    stack_.pop_back();
+                    return;
+                }
+                if (top.second == top.first->children_.size()) {
+                    stack_.pop_back();
+                    continue;
+                }
+                const Node* child = top.first->children_[top.second++].get();
+                stack_.push_back(std::make_pair(child, 0));
+            }
+        }
+
+        std::vector<std::pair<const Node*, std::size_t> > stack_;
+        const Node* leaf_ { nullptr };
+        std::size_t entry_ { 0 };
+    };
+
+    PersistentMap() = default;
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return !size_; }
+
+    const_iterator begin() const { return const_iterator(root_.get()); }
+    const_iterator end() const { return const_iterator(); }
+    const_iterator find(const KeyT& key) const;
+
+    /*!
+     * \brief insertOrAssign
+     *
+     * Return a map with the given binding. This map is left untouched.
+     */
+    PersistentMap insertOrAssign(const KeyT& key, ValueT value) const;
+
+    //! Whether both maps are the very same version (not a deep comparison).
+    bool sameVersion(const PersistentMap& other) const
+    { return root_ == other.root_; }
+
+    /*!
+     * \brief diff
+     *
+     * Call \a f(key, valueInA, valueInB) for each key whose binding may differ
+     * between \a a and \a b; a missing binding is given as null. Subtries that
+     * both maps share are skipped, so the cost is proportional to the
+     * differences rather than to the size of the maps.
+     */
+    template <class FuncT>
+    static void diff(const PersistentMap& a, const PersistentMap& b, FuncT f)
+    { diffCore(a.root_.get(), b.root_.get(), 0, f); }
+
+private:
+    static std::size_t hashOf(const KeyT& key)
+    {
+        // Keys are mostly pointers, whose low bits are always zero. Mix the
+        // bits so that the first levels of the trie are actually used.
+        uint64_t h = HashT()(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+
+    static unsigned slot(std::size_t hash, unsigned shift)
+    { return shift < 8 * sizeof(std::size_t) ? (hash >> shift) & kMask : 0; }
+
+    static unsigned position(uint32_t bitmap, unsigned slot)
+    { return __builtin_popcount(bitmap & ((1u << slot) - 1)); }
+
+    static NodePtr insertCore(const NodePtr& node, std::size_t hash,
+                              unsigned shift, const KeyT& key, ValueT&& value,
+                              bool& added);
+
+    template <class FuncT>
+    static void forEach(const Node* node, bool left, FuncT& f);
+
+    template <class FuncT>
+    static void diffCore(const Node* a, const Node* b, unsigned shift, FuncT& f);
+
+    NodePtr root_;
+    std::size_t size_ { 0 };
+};
+
+template <class KeyT, class ValueT, class HashT>
+typename PersistentMap<KeyT, ValueT, HashT>::const_iterator
+PersistentMap<KeyT, ValueT, HashT>::find(const KeyT& key) const
+{
+    const std::size_t hash = hashOf(key);
+    const Node* node = root_.get();
+    unsigned shift = 0;
+    while (node && !node->isLeaf()) {
+        const unsigned s = slot(hash, shift);
+        if (!(node->bitmap_ & (1u << s)))
+            return end();
+        node = node->children_[position(node->bitmap_, s)].get();
+        shift += kBits;
+    }
+    if (!node || node->hash_ != hash)
+        return end();
+    for (std::size_t i = 0; i < node->entries_.size(); ++i) {
+        if (node->entries_[i].first == key)
+            return const_iterator(node, i);
+    }
+    return end();
+}
+
+template <class KeyT, class ValueT, class HashT>
+PersistentMap<KeyT, ValueT, HashT>
+PersistentMap<KeyT, ValueT, HashT>::insertOrAssign(const KeyT& key,
+                                                   ValueT value) const
+{
+    bool added = false;
+    PersistentMap map;
+    map.root_ = insertCore(root_, hashOf(key), 0, key, std::move(value), added);
+    map.size_ = size_ + (added ? 1 : 0);
+    return map;
+}
+
+template <class KeyT, class ValueT, class HashT>
+typename PersistentMap<KeyT, ValueT, HashT>::NodePtr
+PersistentMap<KeyT, ValueT, HashT>::insertCore(const NodePtr& node,
+                                               std::size_t hash,
+                                               unsigned shift,
+                                               const KeyT& key,
+                                               ValueT&& value,
+                                               bool& added)
+{
+    if (!node) {
+        auto leaf = std::make_shared<Node>();
+        leaf->hash_ = hash;
+        leaf->entries_.emplace_back(key, std::move(value));
+        added = true;
+        return leaf;
+    }
+
+    if (node->isLeaf()) {
+        if (node->hash_ == hash) {
+            auto leaf = std::make_shared<Node>();
+            leaf->hash_ = hash;
+            leaf->entries_.reserve(node->entries_.size() + 1);
+            bool replaced = false;
+            for (const auto& entry : node->entries_) {
+                if (entry.first == key) {
+                    leaf->entries_.emplace_back(key, std::move(value));
+                    replaced = true;
+                } else {
+                    leaf->entries_.push_back(entry);
+                }
+            }
+            if (!replaced) {
+                leaf->entries_.emplace_back(key, std::move(value));
+                added = true;
+            }
+            return leaf;
+        }
+
+        // Two different hashes on the same path: push the existing leaf one
+        // level down and try again.
+        auto branch = std::make_shared<Node>();
+        branch->bitmap_ = 1u << slot(node->hash_, shift);
+        branch->children_.push_back(node);
+        return insertCore(branch, hash, shift, key, std::move(value), added);
+    }
+
+    const unsigned s = slot(hash, shift);
+    const unsigned pos = position(node->bitmap_, s);
+    auto branch = std::make_shared<Node>(*node);
+    if (node->bitmap_ & (1u << s)) {
+        branch->children_[pos] = insertCore(node->children_[pos], hash,
+                                            shift + kBits, key,
+                                            std::move(value), added);
+    } else {
+        branch->bitmap_ |= 1u << s;
+        branch->children_.insert(branch->children_.begin() + pos,
+                                 insertCore(nullptr, hash, shift + kBits, key,
+                                            std::move(value), added));
+    }
+    return branch;
+}
+
+template <class KeyT, class ValueT, class HashT>
+template <class FuncT>
+void PersistentMap<KeyT, ValueT, HashT>::forEach(const Node* node, bool left,
+                                                 FuncT& f)
+{
+    if (!node)
+        return;
+    if (node->isLeaf()) {
+        for (const auto& entry : node->entries_) {
+            if (left)
+                f(entry.first, &entry.second, static_cast<const ValueT*>(nullptr));
+            else
+                f(entry.first, static_cast<const ValueT*>(nullptr), &entry.second);
+        }
+        return;
+    }
+    for (const auto& child : node->children_)
+        forEach(child.get(), left, f);
+}
+
+template <class KeyT, class ValueT, class HashT>
+template <class FuncT>
+void PersistentMap<KeyT, ValueT, HashT>::diffCore(const Node* a, const Node* b,
+                                                  unsigned shift, FuncT& f)
+{
+    if (a == b)
+        return;
+    if (!a || !b) {
+        forEach(a, true, f);
+        forEach(b, false, f);
+        return;
+    }
+
+    if (a->isLeaf() && b->isLeaf()) {
+        for (const auto& entry : a->entries_) {
+            const ValueT* other = nullptr;
+            if (a->hash_ == b->hash_) {
+                for (const auto& candidate : b->entries_) {
+                    if (candidate.first == entry.first)
+                        other = &candidate.second;
+                }
+            }
+            f(entry.first, &entry.second, other);
+        }
+        for (const auto& entry : b->entries_) {
+            bool inA = false;
+            if (a->hash_ == b->hash_) {
+                for (const auto& candidate : a->entries_) {
+                    if (candidate.first == entry.first)
+                        inA = true;
+                }
+            }
+            if (!inA)
+                f(entry.first, static_cast<const ValueT*>(nullptr), &entry.second);
+        }
+        return;
+    }
+
+    // At least one branch. A leaf is seen as a branch with a single child
+    // (itself) in the slot of its hash, since a leaf may sit at any depth.
+    auto childAt = [shift](const Node* node, unsigned s) -> const Node* {
+        if (node->isLeaf())
+            return slot(node->hash_, shift) == s ? node : nullptr;
+        if (!(node->bitmap_ & (1u << s)))
+            return nullptr;
+        return node->children_[position(node->bitmap_, s)].get();
+    };
+    for (unsigned s = 0; s <= kMask; ++s) {
+        const Node* ca = childAt(a, s);
+        const Node* cb = childAt(b, s);
+        if (ca || cb)
+            diffCore(ca, cb, shift + kBits, f);
+    }
+}
+
+} // namespace psyche
+
+#endif
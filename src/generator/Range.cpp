@@ -22,11 +22,13 @@
 #include "Literals.h"
 #include "Symbols.h"
 #include "Debug.h"
+#include "ValueTable.h"
 
 #include <algorithm>
 #include <functional>
 #include <string>
 #include <cmath>
+#include <cstring>
 
 using namespace psyche;
 using namespace CPlusPlus;
@@ -98,7 +100,7 @@ void printOperation(Operation op)
     }
 }
 
-void alertUndefined(AbstractValue& av1, string op, AbstractValue& av2)
+void alertUndefined(const AbstractValue& av1, string op, const AbstractValue& av2)
 {
     if (runingTests)
         return;
@@ -119,22 +121,10 @@ void alertUndefined(AbstractValue& av1, string op, AbstractValue& av2)
 
 Range::Range(std::unique_ptr<AbstractValue> lower,
              std::unique_ptr<AbstractValue> upper)
-    : lower_(std::move(lower))
-    , upper_(std::move(upper))
+    : lower_(ValueTable::instance().intern(std::move(lower)))
+    , upper_(ValueTable::instance().intern(std::move(upper)))
 {}
 
-Range::Range(const Range &range)
-    : lower_(range.lower_->clone())
-    , upper_(range.upper_->clone())
-{}
-
-Range& Range::operator=(const Range& range)
-{
-    lower_ = range.lower_->clone();
-    upper_ = range.upper_->clone();
-    return *this;
-}
-
 Range Range::rangeIntersection(Range* rB)
 {
     std::unique_ptr<AbstractValue> la = lower_->clone();
@@ -202,14 +192,17 @@ Range Range::rangeUnion(const Range &rB)
     return range;
 }
 
-Range Range::evaluate()
+Range Range::evaluate() const
 {
     return Range(lower_->evaluate(), upper_->evaluate());
 }
 
 bool Range::operator==(const Range& rhs) const
 {
-    return *lower_ == *rhs.lower_.get() && *upper_ == *rhs.upper_.get();
+    // Bounds built the same way are the same canonical node. Different nodes
+    // may still be equal (e.g., operands in another order).
+    return (lower_ == rhs.lower_ || *lower_ == *rhs.lower_.get())
+            && (upper_ == rhs.upper_ || *upper_ == *rhs.upper_.get());
 }
 
 bool Range::empty() const
@@ -219,7 +212,7 @@ bool Range::empty() const
 
 bool Range::isConst()
 {
-    return *lower_ == *upper_;
+    return lower_ == upper_ || *lower_ == *upper_;
 }
 
 std::unique_ptr<AbstractValue> Range::upper()
@@ -236,7 +229,7 @@ std::unique_ptr<AbstractValue> Range::lower()
 
 // Auxiliar
 
-std::unique_ptr<AbstractValue> timesMinusOne(AbstractValue& av)
+std::unique_ptr<AbstractValue> timesMinusOne(const AbstractValue& av)
 {
     IntegerValue iv(-1);
     return av * iv;
@@ -340,8 +333,8 @@ std::unique_ptr<AbstractValue> toNAryValue(std::unique_ptr<AbstractValue> v, Ope
 
 // if the integer is greater than the division return 1
 // if not, returns 2
-int integerIsGreaterThanNAryDivision(IntegerValue& iv,
-                                         NAryValue& nv) {
+int integerIsGreaterThanNAryDivision(const IntegerValue& iv,
+                                         const NAryValue& nv) {
     if (nv.terms_.front()->getKindOfValue() == KInteger &&
         nv.terms_.back()->getKindOfValue() == KInteger) {
         IntegerValue* n = static_cast<IntegerValue*>(nv.terms_.front().get());
@@ -404,34 +397,34 @@ std::unique_ptr<AbstractValue> IntegerValue::clone() const
     return std::make_unique<IntegerValue>(value_);
 }
 
-std::string IntegerValue::toString()
+std::string IntegerValue::toString() const
 {
     return std::to_string(value_);
 }
 
-KindOfValue IntegerValue::getKindOfValue()
+KindOfValue IntegerValue::getKindOfValue() const
 {
     return kindOfValue_;
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::evaluate()
+std::unique_ptr<AbstractValue> IntegerValue::evaluate() const
 {
     return std::make_unique<IntegerValue>(value_);
 }
 
-int64_t IntegerValue::getValue()
+int64_t IntegerValue::getValue() const
 {
     return value_;
 }
 
-std::set<std::unique_ptr<AbstractValue> > IntegerValue::asSet()
+std::set<std::unique_ptr<AbstractValue> > IntegerValue::asSet() const
 {
     std::set<std::unique_ptr<AbstractValue> > s;
     s.insert(clone());
     return s;
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator+(NAryValue &nv)
+std::unique_ptr<AbstractValue> IntegerValue::operator+(const NAryValue& nv) const
 {
     if (nv.op_ == Operation::Addition) {
         std::unique_ptr<AbstractValue> tmp = nv.clone();
@@ -450,32 +443,32 @@ std::unique_ptr<AbstractValue> IntegerValue::operator+(NAryValue &nv)
     return NAryValue(clone(), nv.clone(), Operation::Addition).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator+(UndefinedValue &)
+std::unique_ptr<AbstractValue> IntegerValue::operator+(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator+(UnaryValue& ov)
+std::unique_ptr<AbstractValue> IntegerValue::operator+(const UnaryValue& ov) const
 {
     return NAryValue(clone(), ov.evaluate(), Operation::Addition).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator-(NAryValue &nv)
+std::unique_ptr<AbstractValue> IntegerValue::operator-(const NAryValue& nv) const
 {
     return *this + *timesMinusOne(nv);
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator-(UndefinedValue &)
+std::unique_ptr<AbstractValue> IntegerValue::operator-(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator-(UnaryValue& ov)
+std::unique_ptr<AbstractValue> IntegerValue::operator-(const UnaryValue& ov) const
 {
     return *this + *timesMinusOne(ov);
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator*(NAryValue &nv)
+std::unique_ptr<AbstractValue> IntegerValue::operator*(const NAryValue& nv) const
 {
     if (getValue() == 0)
         return IntegerValue(0).evaluate();
@@ -518,36 +511,36 @@ std::unique_ptr<AbstractValue> IntegerValue::operator*(NAryValue &nv)
     return NAryValue(clone(), nv.clone(), Operation::Multiplication).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator*(UndefinedValue &)
+std::unique_ptr<AbstractValue> IntegerValue::operator*(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator*(UnaryValue& ov)
+std::unique_ptr<AbstractValue> IntegerValue::operator*(const UnaryValue& ov) const
 {
     return NAryValue(clone(), ov.evaluate(), Operation::Multiplication).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator/(NAryValue &nv)
+std::unique_ptr<AbstractValue> IntegerValue::operator/(const NAryValue& nv) const
 {
     return NAryValue(clone(), nv.clone(), Operation::Division).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator/(UndefinedValue &)
+std::unique_ptr<AbstractValue> IntegerValue::operator/(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator/(UnaryValue& ov)
+std::unique_ptr<AbstractValue> IntegerValue::operator/(const UnaryValue& ov) const
 {
     return NAryValue(clone(), ov.evaluate(), Operation::Division).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator>>(AbstractValue &av)
+std::unique_ptr<AbstractValue> IntegerValue::operator>>(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = dynamic_cast<IntegerValue&>(av);
+        const IntegerValue& iv = dynamic_cast<const IntegerValue&>(av);
         return (*this >> iv);
     }
     case KSymbol: {
@@ -555,19 +548,19 @@ std::unique_ptr<AbstractValue> IntegerValue::operator>>(AbstractValue &av)
         return (*this >> *nv);
     }
     case KInfinity: {
-        InfinityValue& lv = dynamic_cast<InfinityValue&>(av);
+        const InfinityValue& lv = dynamic_cast<const InfinityValue&>(av);
         return (*this >> lv);
     }
     case KNAry: {
-        NAryValue& nv = dynamic_cast<NAryValue&>(av);
+        const NAryValue& nv = dynamic_cast<const NAryValue&>(av);
         return (*this >> nv);
     }
     case KUndefined: {
-        UndefinedValue& uv = dynamic_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = dynamic_cast<const UndefinedValue&>(av);
         return (*this >> uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this >> ov);
     }
     default:
@@ -575,47 +568,47 @@ std::unique_ptr<AbstractValue> IntegerValue::operator>>(AbstractValue &av)
     }
     r(toString());
     r(av.toString());
-    std::cout << "ERROR: IntegerValue::operator>>(AbstractValue &av)" << std::endl;
+    std::cout << "ERROR: IntegerValue::operator>>(const AbstractValue& av) const" << std::endl;
     exit(1);
     return nullptr;
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator>>(IntegerValue &iv)
+std::unique_ptr<AbstractValue> IntegerValue::operator>>(const IntegerValue& iv) const
 {
     return std::make_unique<IntegerValue>(getValue() >> iv.getValue());
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator>>(SymbolValue &sv)
+std::unique_ptr<AbstractValue> IntegerValue::operator>>(const SymbolValue& sv) const
 {
     return *this >> *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator>>(InfinityValue &iv)
+std::unique_ptr<AbstractValue> IntegerValue::operator>>(const InfinityValue& iv) const
 {
     alertUndefined(*this, ">>", iv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator>>(NAryValue &nv)
+std::unique_ptr<AbstractValue> IntegerValue::operator>>(const NAryValue& nv) const
 {
     return std::make_unique<NAryValue>(clone(), nv.clone(), ShiftRight);
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator>>(UndefinedValue &)
+std::unique_ptr<AbstractValue> IntegerValue::operator>>(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator>>(UnaryValue& ov)
+std::unique_ptr<AbstractValue> IntegerValue::operator>>(const UnaryValue& ov) const
 {
     return NAryValue(clone(), ov.evaluate(), Operation::ShiftRight).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator<<(AbstractValue &av)
+std::unique_ptr<AbstractValue> IntegerValue::operator<<(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = dynamic_cast<IntegerValue&>(av);
+        const IntegerValue& iv = dynamic_cast<const IntegerValue&>(av);
         return (*this << iv);
     }
     case KSymbol: {
@@ -623,19 +616,19 @@ std::unique_ptr<AbstractValue> IntegerValue::operator<<(AbstractValue &av)
         return (*this << *nv);
     }
     case KInfinity: {
-        InfinityValue& lv = dynamic_cast<InfinityValue&>(av);
+        const InfinityValue& lv = dynamic_cast<const InfinityValue&>(av);
         return (*this << lv);
     }
     case KNAry: {
-        NAryValue& nv = dynamic_cast<NAryValue&>(av);
+        const NAryValue& nv = dynamic_cast<const NAryValue&>(av);
         return (*this << nv);
     }
     case KUndefined: {
-        UndefinedValue& uv = dynamic_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = dynamic_cast<const UndefinedValue&>(av);
         return (*this << uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this << ov);
     }
     default:
@@ -643,88 +636,88 @@ std::unique_ptr<AbstractValue> IntegerValue::operator<<(AbstractValue &av)
     }
     r(toString());
     r(av.toString());
-    std::cout << "ERROR: IntegerValue::operator<<(AbstractValue &)" << std::endl;
+    std::cout << "ERROR: IntegerValue::operator<<(const AbstractValue&) const" << std::endl;
     exit(1);
     return nullptr;
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator<<(IntegerValue &iv)
+std::unique_ptr<AbstractValue> IntegerValue::operator<<(const IntegerValue& iv) const
 {
     return std::make_unique<IntegerValue>(getValue() << iv.getValue());
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator<<(SymbolValue &sv)
+std::unique_ptr<AbstractValue> IntegerValue::operator<<(const SymbolValue& sv) const
 {
     return *this << *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator<<(InfinityValue &iv)
+std::unique_ptr<AbstractValue> IntegerValue::operator<<(const InfinityValue& iv) const
 {
     alertUndefined(*this, "<<", iv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator<<(NAryValue &nv)
+std::unique_ptr<AbstractValue> IntegerValue::operator<<(const NAryValue& nv) const
 {
     return std::make_unique<NAryValue>(clone(), nv.clone(), ShiftLeft);
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator<<(UndefinedValue &)
+std::unique_ptr<AbstractValue> IntegerValue::operator<<(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator<<(UnaryValue& ov)
+std::unique_ptr<AbstractValue> IntegerValue::operator<<(const UnaryValue& ov) const
 {
     return NAryValue(clone(), ov.evaluate(), Operation::ShiftLeft).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator+(AbstractValue& av)
+std::unique_ptr<AbstractValue> IntegerValue::operator+(const AbstractValue& av) const
 {
     return av + *this;
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator+(IntegerValue& iv)
+std::unique_ptr<AbstractValue> IntegerValue::operator+(const IntegerValue& iv) const
 {
     return std::make_unique<IntegerValue>(getValue() + iv.getValue());
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator+(SymbolValue& sv)
+std::unique_ptr<AbstractValue> IntegerValue::operator+(const SymbolValue& sv) const
 {
     return NAryValue(clone(), sv.evaluate(), Operation::Addition).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator+(InfinityValue& lv)
+std::unique_ptr<AbstractValue> IntegerValue::operator+(const InfinityValue& lv) const
 {
     return lv.clone();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator-(AbstractValue& av)
+std::unique_ptr<AbstractValue> IntegerValue::operator-(const AbstractValue& av) const
 {
     // a - b = a + ((-1) * b)
     std::unique_ptr<AbstractValue> negAv = timesMinusOne(av);
     return *this + *negAv;
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator-(IntegerValue& iv)
+std::unique_ptr<AbstractValue> IntegerValue::operator-(const IntegerValue& iv) const
 {
     return std::make_unique<IntegerValue>(getValue() - iv.getValue());
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator-(SymbolValue& sv)
+std::unique_ptr<AbstractValue> IntegerValue::operator-(const SymbolValue& sv) const
 {
     // a - b = a + ((-1) * b)
     return *this + *timesMinusOne(*sv.evaluate());
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator-(InfinityValue& lv)
+std::unique_ptr<AbstractValue> IntegerValue::operator-(const InfinityValue& lv) const
 {
     if (lv.getSign() == Sign::Positive)
         return std::make_unique<InfinityValue>(Sign::Negative);
     return std::make_unique<InfinityValue>(Sign::Positive);
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator*(AbstractValue& av)
+std::unique_ptr<AbstractValue> IntegerValue::operator*(const AbstractValue& av) const
 {
     if (getValue() == 0)
         return (std::make_unique<IntegerValue>(0));
@@ -734,12 +727,12 @@ std::unique_ptr<AbstractValue> IntegerValue::operator*(AbstractValue& av)
     return (av * *this);
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator*(IntegerValue& iv)
+std::unique_ptr<AbstractValue> IntegerValue::operator*(const IntegerValue& iv) const
 {
     return std::make_unique<IntegerValue>(getValue() * iv.getValue());
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator*(SymbolValue& sv)
+std::unique_ptr<AbstractValue> IntegerValue::operator*(const SymbolValue& sv) const
 {
     if (getValue() == 0)
         return (std::make_unique<IntegerValue>(0));
@@ -749,7 +742,7 @@ std::unique_ptr<AbstractValue> IntegerValue::operator*(SymbolValue& sv)
                      Operation::Multiplication).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator*(InfinityValue& lv)
+std::unique_ptr<AbstractValue> IntegerValue::operator*(const InfinityValue& lv) const
 {
     if (getValue() > 0) {
         return lv.clone();
@@ -763,11 +756,11 @@ std::unique_ptr<AbstractValue> IntegerValue::operator*(InfinityValue& lv)
     return std::make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator/(AbstractValue& av)
+std::unique_ptr<AbstractValue> IntegerValue::operator/(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = static_cast<IntegerValue&>(av);
+        const IntegerValue& iv = static_cast<const IntegerValue&>(av);
         return (*this/iv);
     }
     case KSymbol: {
@@ -776,19 +769,19 @@ std::unique_ptr<AbstractValue> IntegerValue::operator/(AbstractValue& av)
     }
 
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return (*this/lv);
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return (*this/nv);
     }
     case KUndefined: {
-        UndefinedValue& uv = static_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = static_cast<const UndefinedValue&>(av);
         return (*this / uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this / ov);
     }
     default:
@@ -796,12 +789,12 @@ std::unique_ptr<AbstractValue> IntegerValue::operator/(AbstractValue& av)
     }
     r(toString());
     r(av.toString());
-    std::cout << "ERROR: IntegerValue::operator/(AbstractValue& av)" << std::endl;
+    std::cout << "ERROR: IntegerValue::operator/(const AbstractValue& av) const" << std::endl;
     exit(1);
     return nullptr;
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator/(IntegerValue& iv)
+std::unique_ptr<AbstractValue> IntegerValue::operator/(const IntegerValue& iv) const
 {
     if (iv.getValue() == 1)
         return clone();
@@ -816,7 +809,7 @@ std::unique_ptr<AbstractValue> IntegerValue::operator/(IntegerValue& iv)
                           Operation::Division).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator/(SymbolValue& sv)
+std::unique_ptr<AbstractValue> IntegerValue::operator/(const SymbolValue& sv) const
 {
     if (getValue() == 0)
         return (std::make_unique<IntegerValue>(0));
@@ -826,65 +819,65 @@ std::unique_ptr<AbstractValue> IntegerValue::operator/(SymbolValue& sv)
                           Operation::Division).evaluate();
 }
 
-std::unique_ptr<AbstractValue> IntegerValue::operator/(InfinityValue&)
+std::unique_ptr<AbstractValue> IntegerValue::operator/(const InfinityValue&) const
 {
     return IntegerValue(0).clone();
 }
 
-bool IntegerValue::operator==(AbstractValue& av)
+bool IntegerValue::operator==(const AbstractValue& av) const
 {
     return (av == *this);
 }
 
-bool IntegerValue::operator==(IntegerValue& iv)
+bool IntegerValue::operator==(const IntegerValue& iv) const
 {
     return (getValue() == iv.getValue());
 }
 
-bool IntegerValue::operator==(SymbolValue&) {return false;}
+bool IntegerValue::operator==(const SymbolValue&) const {return false;}
 
-bool IntegerValue::operator==(InfinityValue&) {return false;}
+bool IntegerValue::operator==(const InfinityValue&) const {return false;}
 
-bool IntegerValue::operator==(NAryValue &)
+bool IntegerValue::operator==(const NAryValue&) const
 {
     return false;
 }
 
-bool IntegerValue::operator==(UndefinedValue &)
+bool IntegerValue::operator==(const UndefinedValue&) const
 {
     return false;
 }
 
-bool IntegerValue::operator==(UnaryValue &)
+bool IntegerValue::operator==(const UnaryValue&) const
 {
     return false;
 }
 
-bool IntegerValue::operator<(AbstractValue& av)
+bool IntegerValue::operator<(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = dynamic_cast<IntegerValue&>(av);
+        const IntegerValue& iv = dynamic_cast<const IntegerValue&>(av);
         return (*this < iv);
     }
     case KSymbol: {
-        SymbolValue& sv = dynamic_cast<SymbolValue&>(av);
+        const SymbolValue& sv = dynamic_cast<const SymbolValue&>(av);
         return *this < sv;
     }
     case KInfinity: {
-        InfinityValue& lv = dynamic_cast<InfinityValue&>(av);
+        const InfinityValue& lv = dynamic_cast<const InfinityValue&>(av);
         return *this < lv;
     }
     case KNAry: {
-        NAryValue& nv = dynamic_cast<NAryValue&>(av);
+        const NAryValue& nv = dynamic_cast<const NAryValue&>(av);
         return *this < nv;
     }
     case KUndefined: {
-        UndefinedValue& uv = dynamic_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = dynamic_cast<const UndefinedValue&>(av);
         return (*this < uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this < ov);
     }
     default:
@@ -892,26 +885,26 @@ bool IntegerValue::operator<(AbstractValue& av)
     }
     r(toString());
     r(av.toString());
-    std::cout << "ERROR: IntegerValue::operator<(AbstractValue& av)" << std::endl;
+    std::cout << "ERROR: IntegerValue::operator<(const AbstractValue& av) const" << std::endl;
     exit(1);
     return false;
 }
 
-bool IntegerValue::operator<(IntegerValue& iv)
+bool IntegerValue::operator<(const IntegerValue& iv) const
 {
     return (getValue() < iv.getValue());
 }
 
-bool IntegerValue::operator<(SymbolValue&) {return false;}
+bool IntegerValue::operator<(const SymbolValue&) const {return false;}
 
-bool IntegerValue::operator<(InfinityValue& lv)
+bool IntegerValue::operator<(const InfinityValue& lv) const
 {
     if (lv.getSign() == Sign::Positive)
         return true;
     return false;
 }
 
-bool IntegerValue::operator<(NAryValue& nv)
+bool IntegerValue::operator<(const NAryValue& nv) const
 {
     if (nv.op_ == Division) {
         if (integerIsGreaterThanNAryDivision(*this, nv) == 2)
@@ -923,12 +916,12 @@ bool IntegerValue::operator<(NAryValue& nv)
     return false;
 }
 
-bool IntegerValue::operator<(UndefinedValue &)
+bool IntegerValue::operator<(const UndefinedValue&) const
 {
     return false;
 }
 
-bool IntegerValue::operator<(UnaryValue& ov)
+bool IntegerValue::operator<(const UnaryValue& ov) const
 {
     if (ov.op_ == SquareRoot && getValue() < 0)
         return true;
@@ -936,31 +929,31 @@ bool IntegerValue::operator<(UnaryValue& ov)
     return false;
 }
 
-bool IntegerValue::operator>(AbstractValue& av)
+bool IntegerValue::operator>(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = dynamic_cast<IntegerValue&>(av);
+        const IntegerValue& iv = dynamic_cast<const IntegerValue&>(av);
         return *this > iv;
     }
     case KSymbol: {
-        SymbolValue& sv = dynamic_cast<SymbolValue&>(av);
+        const SymbolValue& sv = dynamic_cast<const SymbolValue&>(av);
         return *this > sv;
     }
     case KInfinity: {
-        InfinityValue& lv = dynamic_cast<InfinityValue&>(av);
+        const InfinityValue& lv = dynamic_cast<const InfinityValue&>(av);
         return *this > lv;
     }
     case KNAry: {
-        NAryValue& nv = dynamic_cast<NAryValue&>(av);
+        const NAryValue& nv = dynamic_cast<const NAryValue&>(av);
         return *this > nv;
     }
     case KUndefined: {
-        UndefinedValue& uv = dynamic_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = dynamic_cast<const UndefinedValue&>(av);
         return (*this > uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this > ov);
     }
     default:
@@ -968,19 +961,19 @@ bool IntegerValue::operator>(AbstractValue& av)
     }
     r(toString());
     r(av.toString());
-    std::cout << "ERROR: IntegerValue::operator>(AbstractValue& av)" << std::endl;
+    std::cout << "ERROR: IntegerValue::operator>(const AbstractValue& av) const" << std::endl;
     exit(1);
     return false;
 }
 
-bool IntegerValue::operator>(IntegerValue& iv)
+bool IntegerValue::operator>(const IntegerValue& iv) const
 {
     return (getValue() > iv.getValue());
 }
 
-bool IntegerValue::operator>(SymbolValue&) {return false;}
+bool IntegerValue::operator>(const SymbolValue&) const {return false;}
 
-bool IntegerValue::operator>(InfinityValue& lv)
+bool IntegerValue::operator>(const InfinityValue& lv) const
 {
     if (lv.getSign() == Sign::Positive)
         return false;
@@ -988,7 +981,7 @@ bool IntegerValue::operator>(InfinityValue& lv)
         return true;
 }
 
-bool IntegerValue::operator>(NAryValue &nv)
+bool IntegerValue::operator>(const NAryValue& nv) const
 {
     if (nv.op_ == Division) {
         if (integerIsGreaterThanNAryDivision(*this, nv) == 1)
@@ -1000,12 +993,12 @@ bool IntegerValue::operator>(NAryValue &nv)
     return false;
 }
 
-bool IntegerValue::operator>(UndefinedValue &)
+bool IntegerValue::operator>(const UndefinedValue&) const
 {
     return false;
 }
 
-bool IntegerValue::operator>(UnaryValue& ov)
+bool IntegerValue::operator>(const UnaryValue& ov) const
 {
     if (ov.op_ == SquareRoot && getValue() < 0)
         return false;
@@ -1020,7 +1013,7 @@ std::unique_ptr<AbstractValue> SymbolValue::clone() const
     return std::make_unique<SymbolValue>(symbol_);
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::evaluate()
+std::unique_ptr<AbstractValue> SymbolValue::evaluate() const
 {
     return std::make_unique<NAryValue>(
                 std::make_unique<IntegerValue>(1),
@@ -1028,102 +1021,102 @@ std::unique_ptr<AbstractValue> SymbolValue::evaluate()
                 Operation::Multiplication);
 }
 
-std::string SymbolValue::toString()
+std::string SymbolValue::toString() const
 {
     const Identifier *id = symbol_->name()->asNameId()->identifier();
     std::string ret(id->begin(), id->end());
     return ret;
 }
 
-KindOfValue SymbolValue::getKindOfValue()
+KindOfValue SymbolValue::getKindOfValue() const
 {
     return kindOfValue_;
 }
 
-void SymbolValue::buildSymbolDependence()
+void SymbolValue::buildSymbolDependence() const
 {
     symbolDep_.clear();
     symbolDep_.insert(symbol_);
 }
 
-std::set<std::unique_ptr<AbstractValue> > SymbolValue::asSet()
+std::set<std::unique_ptr<AbstractValue> > SymbolValue::asSet() const
 {
     std::set<std::unique_ptr<AbstractValue> > s;
     s.insert(clone());
     return s;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator+(NAryValue &nv)
+std::unique_ptr<AbstractValue> SymbolValue::operator+(const NAryValue& nv) const
 {
     return *evaluate() + nv;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator+(UndefinedValue &)
+std::unique_ptr<AbstractValue> SymbolValue::operator+(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator+(UnaryValue& ov)
+std::unique_ptr<AbstractValue> SymbolValue::operator+(const UnaryValue& ov) const
 {
     return NAryValue(evaluate(),
                      ov.evaluate(),
                      Operation::Addition).evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator-(NAryValue &nv)
+std::unique_ptr<AbstractValue> SymbolValue::operator-(const NAryValue& nv) const
 {
     return *evaluate() + *timesMinusOne(nv);
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator-(UndefinedValue &)
+std::unique_ptr<AbstractValue> SymbolValue::operator-(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator-(UnaryValue& ov)
+std::unique_ptr<AbstractValue> SymbolValue::operator-(const UnaryValue& ov) const
 {
     return *evaluate() + *timesMinusOne(ov);
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator*(NAryValue &nv)
+std::unique_ptr<AbstractValue> SymbolValue::operator*(const NAryValue& nv) const
 {
     return *evaluate() * nv;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator*(UndefinedValue &)
+std::unique_ptr<AbstractValue> SymbolValue::operator*(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator*(UnaryValue& ov)
+std::unique_ptr<AbstractValue> SymbolValue::operator*(const UnaryValue& ov) const
 {
     return NAryValue(evaluate(),
                      ov.evaluate(),
                      Operation::Multiplication).evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator/(NAryValue &nv)
+std::unique_ptr<AbstractValue> SymbolValue::operator/(const NAryValue& nv) const
 {
     return *evaluate() / nv;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator/(UndefinedValue &)
+std::unique_ptr<AbstractValue> SymbolValue::operator/(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator/(UnaryValue& ov)
+std::unique_ptr<AbstractValue> SymbolValue::operator/(const UnaryValue& ov) const
 {
     return NAryValue(evaluate(),
                      ov.evaluate(),
                      Operation::Division).evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator>>(AbstractValue &av)
+std::unique_ptr<AbstractValue> SymbolValue::operator>>(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = dynamic_cast<IntegerValue&>(av);
+        const IntegerValue& iv = dynamic_cast<const IntegerValue&>(av);
         return (*this >> iv);
     }
     case KSymbol: {
@@ -1131,69 +1124,69 @@ std::unique_ptr<AbstractValue> SymbolValue::operator>>(AbstractValue &av)
         return (*this >> *sv);
     }
     case KInfinity: {
-        InfinityValue& lv = dynamic_cast<InfinityValue&>(av);
+        const InfinityValue& lv = dynamic_cast<const InfinityValue&>(av);
         return (*this >> lv);
     }
     case KNAry: {
-        NAryValue& nv = dynamic_cast<NAryValue&>(av);
+        const NAryValue& nv = dynamic_cast<const NAryValue&>(av);
         return (*this >> nv);
     }
     case KUndefined: {
-        UndefinedValue& uv = dynamic_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = dynamic_cast<const UndefinedValue&>(av);
         return (*this >> uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this >> ov);
     }
     default:
         break;
     }
-    std::cout << "ERROR: SymbolValue::operator>>(AbstractValue &av)" << std::endl;
+    std::cout << "ERROR: SymbolValue::operator>>(const AbstractValue& av) const" << std::endl;
     exit(1);
     return nullptr;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator>>(IntegerValue &iv)
+std::unique_ptr<AbstractValue> SymbolValue::operator>>(const IntegerValue& iv) const
 {
     IntegerValue q(1 << iv.getValue());
 
     return *evaluate() / q;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator>>(SymbolValue &sv)
+std::unique_ptr<AbstractValue> SymbolValue::operator>>(const SymbolValue& sv) const
 {
     return *clone() >> *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator>>(InfinityValue &lv)
+std::unique_ptr<AbstractValue> SymbolValue::operator>>(const InfinityValue& lv) const
 {
     alertUndefined(*this, ">>", lv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator>>(NAryValue &nv)
+std::unique_ptr<AbstractValue> SymbolValue::operator>>(const NAryValue& nv) const
 {
     return *evaluate() >> nv;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator>>(UndefinedValue &)
+std::unique_ptr<AbstractValue> SymbolValue::operator>>(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator>>(UnaryValue& ov)
+std::unique_ptr<AbstractValue> SymbolValue::operator>>(const UnaryValue& ov) const
 {
     return NAryValue(evaluate(),
                      ov.evaluate(),
                      Operation::ShiftRight).evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator<<(AbstractValue &av)
+std::unique_ptr<AbstractValue> SymbolValue::operator<<(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = static_cast<IntegerValue&>(av);
+        const IntegerValue& iv = static_cast<const IntegerValue&>(av);
         return (*this << iv);
     }
     case KSymbol: {
@@ -1201,135 +1194,135 @@ std::unique_ptr<AbstractValue> SymbolValue::operator<<(AbstractValue &av)
         return (*this << *sv);
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return (*this << lv);
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return (*this << nv);
     }
     case KUndefined: {
-        UndefinedValue& uv = static_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = static_cast<const UndefinedValue&>(av);
         return (*this << uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this << ov);
     }
     default:
         break;
     }
-    std::cout << "ERROR: SymbolValue::operator<<(AbstractValue &av)" << std::endl;
+    std::cout << "ERROR: SymbolValue::operator<<(const AbstractValue& av) const" << std::endl;
     exit(1);
     return nullptr;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator<<(NAryValue &nv)
+std::unique_ptr<AbstractValue> SymbolValue::operator<<(const NAryValue& nv) const
 {
     return *evaluate() << nv;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator<<(UndefinedValue &)
+std::unique_ptr<AbstractValue> SymbolValue::operator<<(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator<<(UnaryValue& ov)
+std::unique_ptr<AbstractValue> SymbolValue::operator<<(const UnaryValue& ov) const
 {
     return NAryValue(evaluate(),
                      ov.evaluate(),
                      Operation::ShiftLeft).evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator<<(IntegerValue &iv)
+std::unique_ptr<AbstractValue> SymbolValue::operator<<(const IntegerValue& iv) const
 {
     IntegerValue q(1 << iv.getValue());
 
     return *evaluate() * q;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator<<(SymbolValue &sv)
+std::unique_ptr<AbstractValue> SymbolValue::operator<<(const SymbolValue& sv) const
 {
     return *evaluate() << *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator<<(InfinityValue &lv)
+std::unique_ptr<AbstractValue> SymbolValue::operator<<(const InfinityValue& lv) const
 {
     alertUndefined(*this, "<<", lv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator+(AbstractValue& av)
+std::unique_ptr<AbstractValue> SymbolValue::operator+(const AbstractValue& av) const
 {
     return (av + *evaluate());
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator+(IntegerValue& iv)
+std::unique_ptr<AbstractValue> SymbolValue::operator+(const IntegerValue& iv) const
 {
     return *evaluate() + iv;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator+(SymbolValue& sv)
+std::unique_ptr<AbstractValue> SymbolValue::operator+(const SymbolValue& sv) const
 {
     return *evaluate() + *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator+(InfinityValue& lv)
+std::unique_ptr<AbstractValue> SymbolValue::operator+(const InfinityValue& lv) const
 {
     return lv.clone();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator-(AbstractValue& av)
+std::unique_ptr<AbstractValue> SymbolValue::operator-(const AbstractValue& av) const
 {
     return *evaluate() + *timesMinusOne(av);
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator-(IntegerValue& iv)
+std::unique_ptr<AbstractValue> SymbolValue::operator-(const IntegerValue& iv) const
 {
     return *evaluate() + *timesMinusOne(iv);
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator-(SymbolValue& sv)
+std::unique_ptr<AbstractValue> SymbolValue::operator-(const SymbolValue& sv) const
 {
     return *evaluate() + *timesMinusOne(*sv.evaluate());
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator-(InfinityValue& lv)
+std::unique_ptr<AbstractValue> SymbolValue::operator-(const InfinityValue& lv) const
 {
     if (lv.getSign() == Sign::Positive)
         return std::make_unique<InfinityValue>(Sign::Negative);
     return std::make_unique<InfinityValue>(Sign::Positive);
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator*(AbstractValue& av)
+std::unique_ptr<AbstractValue> SymbolValue::operator*(const AbstractValue& av) const
 {
     return (av * *evaluate());
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator*(IntegerValue& iv)
+std::unique_ptr<AbstractValue> SymbolValue::operator*(const IntegerValue& iv) const
 {
     return NAryValue(evaluate(),
                      iv.clone(),
                      Operation::Multiplication).evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator*(SymbolValue& sv)
+std::unique_ptr<AbstractValue> SymbolValue::operator*(const SymbolValue& sv) const
 {
     return *evaluate() * *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator*(InfinityValue& lv)
+std::unique_ptr<AbstractValue> SymbolValue::operator*(const InfinityValue& lv) const
 {
     alertUndefined(*this, "*", lv);
     return std::make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator/(AbstractValue& av)
+std::unique_ptr<AbstractValue> SymbolValue::operator/(const AbstractValue& av) const
 {
     return *evaluate() / av;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator/(IntegerValue& iv)
+std::unique_ptr<AbstractValue> SymbolValue::operator/(const IntegerValue& iv) const
 {
     if (iv.getValue() == 1)
         return evaluate();
@@ -1342,31 +1335,31 @@ std::unique_ptr<AbstractValue> SymbolValue::operator/(IntegerValue& iv)
     return *evaluate() / iv;
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator/(SymbolValue& sv)
+std::unique_ptr<AbstractValue> SymbolValue::operator/(const SymbolValue& sv) const
 {
     return *evaluate() / *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> SymbolValue::operator/(InfinityValue&)
+std::unique_ptr<AbstractValue> SymbolValue::operator/(const InfinityValue&) const
 {
     return std::make_unique<IntegerValue>(0);
 }
 
-bool SymbolValue::operator==(AbstractValue& av)
+bool SymbolValue::operator==(const AbstractValue& av) const
 {
     return (av == *this);
 }
 
-bool SymbolValue::operator==(IntegerValue&) {return false;}
+bool SymbolValue::operator==(const IntegerValue&) const {return false;}
 
-bool SymbolValue::operator==(SymbolValue& sv)
+bool SymbolValue::operator==(const SymbolValue& sv) const
 {
     return (toString().compare(sv.toString()) == 0);
 }
 
-bool SymbolValue::operator==(InfinityValue&) {return false;}
+bool SymbolValue::operator==(const InfinityValue&) const {return false;}
 
-bool SymbolValue::operator==(NAryValue& nv)
+bool SymbolValue::operator==(const NAryValue& nv) const
 {
     if (nv.isTimesOne()) { // 1*s1
         AV av = nv.clone();
@@ -1390,17 +1383,17 @@ bool SymbolValue::operator==(NAryValue& nv)
     return  false;
 }
 
-bool SymbolValue::operator==(UndefinedValue &)
+bool SymbolValue::operator==(const UndefinedValue&) const
 {
     return false;
 }
 
-bool SymbolValue::operator==(UnaryValue &)
+bool SymbolValue::operator==(const UnaryValue&) const
 {
     return false;
 }
 
-bool SymbolValue::operator<(AbstractValue& av)
+bool SymbolValue::operator<(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
@@ -1410,15 +1403,15 @@ bool SymbolValue::operator<(AbstractValue& av)
         return false;
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return *this < lv;
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return *evaluate() < nv;
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this < ov);
     }
     default:
@@ -1428,33 +1421,33 @@ bool SymbolValue::operator<(AbstractValue& av)
     return false;
 }
 
-bool SymbolValue::operator<(IntegerValue&) {return false;}
+bool SymbolValue::operator<(const IntegerValue&) const {return false;}
 
-bool SymbolValue::operator<(SymbolValue&) {return false;}
+bool SymbolValue::operator<(const SymbolValue&) const {return false;}
 
-bool SymbolValue::operator<(InfinityValue& lv)
+bool SymbolValue::operator<(const InfinityValue& lv) const
 {
     if (lv.getSign() == Sign::Positive)
         return true;
     return false;
 }
 
-bool SymbolValue::operator<(NAryValue& nv)
+bool SymbolValue::operator<(const NAryValue& nv) const
 {
     return *evaluate() < nv;
 }
 
-bool SymbolValue::operator<(UndefinedValue &)
+bool SymbolValue::operator<(const UndefinedValue&) const
 {
     return false;
 }
 
-bool SymbolValue::operator<(UnaryValue &)
+bool SymbolValue::operator<(const UnaryValue&) const
 {
     return false;
 }
 
-bool SymbolValue::operator>(AbstractValue& av)
+bool SymbolValue::operator>(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
@@ -1464,15 +1457,15 @@ bool SymbolValue::operator>(AbstractValue& av)
         return false;
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return *this > lv;
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return *evaluate() > nv;
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this > ov);
     }
     default:
@@ -1482,28 +1475,28 @@ bool SymbolValue::operator>(AbstractValue& av)
     return false;
 }
 
-bool SymbolValue::operator>(IntegerValue&) {return false;}
+bool SymbolValue::operator>(const IntegerValue&) const {return false;}
 
-bool SymbolValue::operator>(SymbolValue&) {return false;}
+bool SymbolValue::operator>(const SymbolValue&) const {return false;}
 
-bool SymbolValue::operator>(InfinityValue& lv)
+bool SymbolValue::operator>(const InfinityValue& lv) const
 {
     if (lv.getSign() == Sign::Positive)
         return false;
     return true;
 }
 
-bool SymbolValue::operator>(NAryValue& nv)
+bool SymbolValue::operator>(const NAryValue& nv) const
 {
     return *evaluate() > nv;
 }
 
-bool SymbolValue::operator>(UndefinedValue &)
+bool SymbolValue::operator>(const UndefinedValue&) const
 {
     return false;
 }
 
-bool SymbolValue::operator>(UnaryValue &)
+bool SymbolValue::operator>(const UnaryValue&) const
 {
     return false;
 }
@@ -1515,12 +1508,12 @@ std::unique_ptr<AbstractValue> InfinityValue::clone() const
     return std::make_unique<InfinityValue>(sign_);
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::evaluate()
+std::unique_ptr<AbstractValue> InfinityValue::evaluate() const
 {
     return std::make_unique<InfinityValue>(sign_);
 }
 
-std::string InfinityValue::toString()
+std::string InfinityValue::toString() const
 {
     if (sign_ == Positive)
       return "+Inf";
@@ -1528,185 +1521,185 @@ std::string InfinityValue::toString()
       return "-Inf";
 }
 
-KindOfValue InfinityValue::getKindOfValue()
+KindOfValue InfinityValue::getKindOfValue() const
 {
     return kindOfValue_;
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator+(NAryValue &nv)
+std::unique_ptr<AbstractValue> InfinityValue::operator+(const NAryValue& nv) const
 {
     return clone();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator+(UndefinedValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator+(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator+(UnaryValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator+(const UnaryValue&) const
 {
     return clone();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator*(NAryValue &nv)
+std::unique_ptr<AbstractValue> InfinityValue::operator*(const NAryValue& nv) const
 {
     alertUndefined(*this, "*", nv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator*(UndefinedValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator*(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator*(UnaryValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator*(const UnaryValue&) const
 {
     alertUndefined(*this, "sqrt", *IntegerValue(2).clone());
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator/(NAryValue &nv)
+std::unique_ptr<AbstractValue> InfinityValue::operator/(const NAryValue& nv) const
 {
     alertUndefined(*this, "/", nv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator/(UndefinedValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator/(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator/(UnaryValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator/(const UnaryValue&) const
 {
     alertUndefined(*this, "sqrt", *IntegerValue(2).clone());
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator>>(AbstractValue &av)
+std::unique_ptr<AbstractValue> InfinityValue::operator>>(const AbstractValue& av) const
 {
     alertUndefined(*this, ">>", av);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator>>(IntegerValue &iv)
+std::unique_ptr<AbstractValue> InfinityValue::operator>>(const IntegerValue& iv) const
 {
     alertUndefined(*this, ">>", iv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator>>(SymbolValue &sv)
+std::unique_ptr<AbstractValue> InfinityValue::operator>>(const SymbolValue& sv) const
 {
     alertUndefined(*this, ">>", sv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator>>(InfinityValue &lv)
+std::unique_ptr<AbstractValue> InfinityValue::operator>>(const InfinityValue& lv) const
 {
     alertUndefined(*this, ">>", lv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator>>(NAryValue &nv)
+std::unique_ptr<AbstractValue> InfinityValue::operator>>(const NAryValue& nv) const
 {
     alertUndefined(*this, ">>", nv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator>>(UndefinedValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator>>(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator>>(UnaryValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator>>(const UnaryValue&) const
 {
     alertUndefined(*this, "sqrt", *IntegerValue(2).clone());
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator<<(AbstractValue &av)
+std::unique_ptr<AbstractValue> InfinityValue::operator<<(const AbstractValue& av) const
 {
     alertUndefined(*this, "<<", av);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator<<(IntegerValue &iv)
+std::unique_ptr<AbstractValue> InfinityValue::operator<<(const IntegerValue& iv) const
 {
     alertUndefined(*this, "<<", iv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator<<(SymbolValue &sv)
+std::unique_ptr<AbstractValue> InfinityValue::operator<<(const SymbolValue& sv) const
 {
     alertUndefined(*this, "<<", sv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator<<(InfinityValue &lv)
+std::unique_ptr<AbstractValue> InfinityValue::operator<<(const InfinityValue& lv) const
 {
     alertUndefined(*this, "<<", lv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator<<(NAryValue &nv)
+std::unique_ptr<AbstractValue> InfinityValue::operator<<(const NAryValue& nv) const
 {
     alertUndefined(*this, "<<", nv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator<<(UndefinedValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator<<(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator<<(UnaryValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator<<(const UnaryValue&) const
 {
     alertUndefined(*this, "sqrt", *IntegerValue(2).clone());
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator-(NAryValue &nv)
+std::unique_ptr<AbstractValue> InfinityValue::operator-(const NAryValue& nv) const
 {
     return clone();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator-(UndefinedValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator-(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator-(UnaryValue &)
+std::unique_ptr<AbstractValue> InfinityValue::operator-(const UnaryValue&) const
 {
     return clone();
 }
 
-Sign InfinityValue::getSign()
+Sign InfinityValue::getSign() const
 {
     return sign_;
 }
 
-std::set<std::unique_ptr<AbstractValue> > InfinityValue::asSet()
+std::set<std::unique_ptr<AbstractValue> > InfinityValue::asSet() const
 {
     std::set<std::unique_ptr<AbstractValue> > s;
     s.insert(clone());
     return s;
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator+(AbstractValue& av)
+std::unique_ptr<AbstractValue> InfinityValue::operator+(const AbstractValue& av) const
 {
     return (av + *this);
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator+(IntegerValue& iv)
+std::unique_ptr<AbstractValue> InfinityValue::operator+(const IntegerValue& iv) const
 {
     return clone();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator+(SymbolValue& sv)
+std::unique_ptr<AbstractValue> InfinityValue::operator+(const SymbolValue& sv) const
 {
     return clone();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator+(InfinityValue& lv)
+std::unique_ptr<AbstractValue> InfinityValue::operator+(const InfinityValue& lv) const
 {
     if (getSign() == lv.getSign())
         return clone();
@@ -1715,22 +1708,22 @@ std::unique_ptr<AbstractValue> InfinityValue::operator+(InfinityValue& lv)
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator-(AbstractValue& av)
+std::unique_ptr<AbstractValue> InfinityValue::operator-(const AbstractValue& av) const
 {
     return *this + *timesMinusOne(av);
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator-(IntegerValue& iv)
+std::unique_ptr<AbstractValue> InfinityValue::operator-(const IntegerValue& iv) const
 {
     return clone();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator-(SymbolValue& sv)
+std::unique_ptr<AbstractValue> InfinityValue::operator-(const SymbolValue& sv) const
 {
     return clone();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator-(InfinityValue& lv)
+std::unique_ptr<AbstractValue> InfinityValue::operator-(const InfinityValue& lv) const
 {
     if (getSign() != lv.getSign())
         return clone();
@@ -1739,12 +1732,12 @@ std::unique_ptr<AbstractValue> InfinityValue::operator-(InfinityValue& lv)
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator*(AbstractValue& av)
+std::unique_ptr<AbstractValue> InfinityValue::operator*(const AbstractValue& av) const
 {
     return av * *this;
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator*(IntegerValue& iv)
+std::unique_ptr<AbstractValue> InfinityValue::operator*(const IntegerValue& iv) const
 {
     if (iv.getValue() > 0) {
         return clone();
@@ -1758,26 +1751,26 @@ std::unique_ptr<AbstractValue> InfinityValue::operator*(IntegerValue& iv)
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator*(SymbolValue& sv)
+std::unique_ptr<AbstractValue> InfinityValue::operator*(const SymbolValue& sv) const
 {
     alertUndefined(*this, "*", sv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator*(InfinityValue& lv)
+std::unique_ptr<AbstractValue> InfinityValue::operator*(const InfinityValue& lv) const
 {
     if (getSign() == lv.getSign())
         return make_unique<InfinityValue>(Positive);
     return make_unique<InfinityValue>(Negative);
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator/(AbstractValue& av)
+std::unique_ptr<AbstractValue> InfinityValue::operator/(const AbstractValue& av) const
 {
     alertUndefined(*this, "/", av);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator/(IntegerValue& iv)
+std::unique_ptr<AbstractValue> InfinityValue::operator/(const IntegerValue& iv) const
 {
     if (iv.getValue() > 0) {
         return clone();
@@ -1791,48 +1784,48 @@ std::unique_ptr<AbstractValue> InfinityValue::operator/(IntegerValue& iv)
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator/(SymbolValue& sv)
+std::unique_ptr<AbstractValue> InfinityValue::operator/(const SymbolValue& sv) const
 {
     alertUndefined(*this, "/", sv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> InfinityValue::operator/(InfinityValue& lv)
+std::unique_ptr<AbstractValue> InfinityValue::operator/(const InfinityValue& lv) const
 {
     alertUndefined(*this, "/", lv);
     return UndefinedValue().evaluate();
 }
 
-bool InfinityValue::operator==(AbstractValue& av)
+bool InfinityValue::operator==(const AbstractValue& av) const
 {
     return (av == *this);
 }
 
-bool InfinityValue::operator==(IntegerValue& iv) {return false;}
+bool InfinityValue::operator==(const IntegerValue& iv) const {return false;}
 
-bool InfinityValue::operator==(SymbolValue& sv) {return false;}
+bool InfinityValue::operator==(const SymbolValue& sv) const {return false;}
 
-bool InfinityValue::operator==(InfinityValue& lv)
+bool InfinityValue::operator==(const InfinityValue& lv) const
 {
     return (getSign() == lv.getSign());
 }
 
-bool InfinityValue::operator==(NAryValue &)
+bool InfinityValue::operator==(const NAryValue&) const
 {
     return false;
 }
 
-bool InfinityValue::operator==(UndefinedValue &)
+bool InfinityValue::operator==(const UndefinedValue&) const
 {
     return false;
 }
 
-bool InfinityValue::operator==(UnaryValue &)
+bool InfinityValue::operator==(const UnaryValue&) const
 {
     return false;
 }
 
-bool InfinityValue::operator<(AbstractValue& av)
+bool InfinityValue::operator<(const AbstractValue& av) const
 {
     if (av.getKindOfValue() == KUndefined)
         return false;
@@ -1842,43 +1835,43 @@ bool InfinityValue::operator<(AbstractValue& av)
     return false;
 }
 
-bool InfinityValue::operator<(IntegerValue& iv)
+bool InfinityValue::operator<(const IntegerValue& iv) const
 {
     return (iv > *this);
 }
 
-bool InfinityValue::operator<(SymbolValue& sv)
+bool InfinityValue::operator<(const SymbolValue& sv) const
 {
     return (*clone() > *this);
 }
 
-bool InfinityValue::operator<(InfinityValue& lv)
+bool InfinityValue::operator<(const InfinityValue& lv) const
 {
     if (getSign() == Sign::Negative && lv.getSign() == Sign::Positive)
         return true;
     return false;
 }
 
-bool InfinityValue::operator<(NAryValue &)
+bool InfinityValue::operator<(const NAryValue&) const
 {
     if (getSign() == Sign::Negative)
         return true;
     return false;
 }
 
-bool InfinityValue::operator<(UndefinedValue &)
+bool InfinityValue::operator<(const UndefinedValue&) const
 {
     return false;
 }
 
-bool InfinityValue::operator<(UnaryValue &)
+bool InfinityValue::operator<(const UnaryValue&) const
 {
     if (getSign() == Sign::Negative)
         return true;
     return false;
 }
 
-bool InfinityValue::operator>(AbstractValue& av)
+bool InfinityValue::operator>(const AbstractValue& av) const
 {
     if (av.getKindOfValue() == KUndefined)
         return false;
@@ -1888,40 +1881,40 @@ bool InfinityValue::operator>(AbstractValue& av)
     return false;
 }
 
-bool InfinityValue::operator>(IntegerValue& iv)
+bool InfinityValue::operator>(const IntegerValue& iv) const
 {
     if (getSign() == Sign::Positive)
         return true;
     return false;
 }
 
-bool InfinityValue::operator>(SymbolValue& sv)
+bool InfinityValue::operator>(const SymbolValue& sv) const
 {
     if (getSign() == Sign::Positive)
         return true;
     return false;
 }
 
-bool InfinityValue::operator>(InfinityValue& lv)
+bool InfinityValue::operator>(const InfinityValue& lv) const
 {
     if (getSign() == Sign::Positive && lv.getSign() == Sign::Negative)
         return true;
     return false;
 }
 
-bool InfinityValue::operator>(NAryValue &)
+bool InfinityValue::operator>(const NAryValue&) const
 {
     if (getSign() == Sign::Positive)
         return true;
     return false;
 }
 
-bool InfinityValue::operator>(UndefinedValue &)
+bool InfinityValue::operator>(const UndefinedValue&) const
 {
     return false;
 }
 
-bool InfinityValue::operator>(UnaryValue &)
+bool InfinityValue::operator>(const UnaryValue&) const
 {
     if (getSign() == Sign::Positive)
         return true;
@@ -1971,7 +1964,7 @@ std::unique_ptr<AbstractValue> NAryValue::clone() const
     return std::make_unique<NAryValue>(terms, op_);
 }
 
-std::list<std::unique_ptr<AbstractValue> > NAryValue::termsClone()
+std::list<std::unique_ptr<AbstractValue> > NAryValue::termsClone() const
 {
     std::list<std::unique_ptr<AbstractValue> > terms;
 
@@ -1982,7 +1975,19 @@ std::list<std::unique_ptr<AbstractValue> > NAryValue::termsClone()
     return terms;
 }
 
-std::unique_ptr<AbstractValue> NAryValue::evaluate()
+std::unique_ptr<AbstractValue> NAryValue::evaluate() const
+{
+    ValueTable& table = ValueTable::instance();
+    const ValueTable::Id id = table.idOf(*this);
+    if (std::unique_ptr<AbstractValue> cached = table.normalForm(id, ValueTable::Evaluated))
+        return cached;
+
+    std::unique_ptr<AbstractValue> value = evaluateUncached();
+    table.setNormalForm(id, ValueTable::Evaluated, *value);
+    return value;
+}
+
+std::unique_ptr<AbstractValue> NAryValue::evaluateUncached() const
 {
     if (terms_.size() == 1)
         return terms_.front()->evaluate();
@@ -1992,26 +1997,31 @@ std::unique_ptr<AbstractValue> NAryValue::evaluate()
             return UndefinedValue().evaluate();
         }
     }
-    // try to simplify the NAry value
-    std::unique_ptr<AbstractValue> old;
+    // try to simplify the NAry value. Work on a copy, since this value may be
+    // the canonical node of some Range, and compare the structural ids of the
+    // rounds rather than keeping a clone of the previous one.
+    std::unique_ptr<AbstractValue> result = clone();
+    NAryValue& nv = *static_cast<NAryValue*>(result.get());
+    ValueTable& table = ValueTable::instance();
+    ValueTable::Id old;
     do {
-        old = clone();
-        simplify();
+        old = table.idOf(nv, true);
+        nv.simplify();
         // check if some term is an undefined value
-        for (auto &it : terms_) {
+        for (auto &it : nv.terms_) {
             if (it.get()->getKindOfValue() == KUndefined) {
                 return UndefinedValue().evaluate();
             }
         }
 
-        if (terms_.size() == 1)
-            return terms_.front()->evaluate();
+        if (nv.terms_.size() == 1)
+            return nv.terms_.front()->evaluate();
 
         std::list<std::unique_ptr<AbstractValue> > terms;
 
-        for (auto &it : terms_) {
+        for (auto &it : nv.terms_) {
             if (it.get()->getKindOfValue() == KSymbol) {
-                if (op_ == Multiplication && terms_.size() == 1) {
+                if (nv.op_ == Multiplication && nv.terms_.size() == 1) {
                     terms.push_back(it.get()->evaluate());
                 } else
                     terms.push_back(it.get()->clone());
@@ -2019,15 +2029,27 @@ std::unique_ptr<AbstractValue> NAryValue::evaluate()
                 terms.push_back(it.get()->evaluate());
         }
 
-        terms_.clear();
-        terms_.merge(terms);
+        nv.terms_.clear();
+        nv.terms_.merge(terms);
 
-    } while (!(*old == *this));
+    } while (table.idOf(nv, true) != old);
 
-    return clone();
+    return result;
+}
+
+std::unique_ptr<AbstractValue> NAryValue::develop() const
+{
+    ValueTable& table = ValueTable::instance();
+    const ValueTable::Id id = table.idOf(*this);
+    if (std::unique_ptr<AbstractValue> cached = table.normalForm(id, ValueTable::Developed))
+        return cached;
+
+    std::unique_ptr<AbstractValue> value = developUncached();
+    table.setNormalForm(id, ValueTable::Developed, *value);
+    return value;
 }
 
-std::unique_ptr<AbstractValue> NAryValue::develop()
+std::unique_ptr<AbstractValue> NAryValue::developUncached() const
 {
     // just a copy of the terms
     std::list<std::unique_ptr<AbstractValue> > terms;
@@ -2086,22 +2108,37 @@ std::unique_ptr<AbstractValue> NAryValue::develop()
     }
 }
 
-std::string NAryValue::toString()
+std::string NAryValue::toString() const
 {
     if (terms_.empty())
         return "empty";
 
-    // simplify the number before print it
+    // simplify the number before print it, in a copy: the node may be
+    // shared by several Ranges
     if (!debugEnabled) {
-        removeTimesOne();
-        removeSumToZero();
+        std::unique_ptr<AbstractValue> value = clone();
+        NAryValue& simplified = static_cast<NAryValue&>(*value);
+        simplified.removeTimesOne();
+        simplified.removeSumToZero();
+        return simplified.termsToString();
     }
+    return termsToString();
+}
+
+std::string NAryValue::termsToString() const
+{
+    // The NAry terms are printed as they are, already simplified.
+    auto termToString = [](const std::unique_ptr<AbstractValue>& term) {
+        return term->getKindOfValue() == KNAry
+                ? static_cast<const NAryValue&>(*term).termsToString()
+                : term->toString();
+    };
 
     if (terms_.empty())
         return "empty";
 
     if (terms_.size() == 1)
-        return terms_.front()->toString();
+        return termToString(terms_.front());
 
     std::string op, exp = "(";
 
@@ -2134,10 +2171,10 @@ std::string NAryValue::toString()
         break;
     }
 
-    exp += terms_.front().get()->toString();
+    exp += termToString(terms_.front());
     for (auto it = std::next(terms_.begin()); it != terms_.end(); ++it) {
         exp += op;
-        exp += it->get()->toString();
+        exp += termToString(*it);
     }
 
     exp += ")";
@@ -2145,8 +2182,27 @@ std::string NAryValue::toString()
     return exp;
 }
 
-string NAryValue::toCCode()
+string NAryValue::toCCode() const
 {
+    // Simplified as toString
+    if (!debugEnabled && !terms_.empty()) {
+        std::unique_ptr<AbstractValue> value = clone();
+        NAryValue& simplified = static_cast<NAryValue&>(*value);
+        simplified.removeTimesOne();
+        simplified.removeSumToZero();
+        return simplified.termsToCCode();
+    }
+    return termsToCCode();
+}
+
+string NAryValue::termsToCCode() const
+{
+    auto termToCCode = [](const std::unique_ptr<AbstractValue>& term) {
+        return term->getKindOfValue() == KNAry
+                ? static_cast<const NAryValue&>(*term).termsToCCode()
+                : term->toCCode();
+    };
+
     if (terms_.empty())
         return "empty";
 
@@ -2184,10 +2240,10 @@ string NAryValue::toCCode()
     if (op_ == Operation::Maximum || op_ == Operation::Minimum) {
         exp += std::to_string(terms_.size()) + op;
     }
-    exp += terms_.front().get()->toCCode();
+    exp += termToCCode(terms_.front());
     for (auto it = std::next(terms_.begin()); it != terms_.end(); ++it) {
         exp += op;
-        exp += it->get()->toCCode();
+        exp += termToCCode(*it);
     }
 
     exp += ")";
@@ -2195,12 +2251,12 @@ string NAryValue::toCCode()
     return exp;
 }
 
-KindOfValue NAryValue::getKindOfValue()
+KindOfValue NAryValue::getKindOfValue() const
 {
     return kindOfValue_;
 }
 
-void NAryValue::buildSymbolDependence()
+void NAryValue::buildSymbolDependence() const
 {
     symbolDep_.clear();
     for (auto t = terms_.begin(); t != terms_.end(); ++t) {
@@ -2212,7 +2268,7 @@ void NAryValue::buildSymbolDependence()
     }
 }
 
-std::set<std::unique_ptr<AbstractValue> > NAryValue::asSet()
+std::set<std::unique_ptr<AbstractValue> > NAryValue::asSet() const
 {
     std::set<std::unique_ptr<AbstractValue> > s;
     // TODO
@@ -2243,12 +2299,12 @@ void NAryValue::add(std::unique_ptr<AbstractValue> v)
         terms_.push_back(std::move(v));
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator+(AbstractValue& av)
+std::unique_ptr<AbstractValue> NAryValue::operator+(const AbstractValue& av) const
 {
     return (av + *this);
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator+(IntegerValue& iv)
+std::unique_ptr<AbstractValue> NAryValue::operator+(const IntegerValue& iv) const
 {
     if (op_ == Operation::Addition) {
         std::unique_ptr<AbstractValue> tmp = clone();
@@ -2267,17 +2323,17 @@ std::unique_ptr<AbstractValue> NAryValue::operator+(IntegerValue& iv)
     return NAryValue(clone(), iv.clone(), Operation::Addition).evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator+(SymbolValue& sv)
+std::unique_ptr<AbstractValue> NAryValue::operator+(const SymbolValue& sv) const
 {
     return *this + *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator+(InfinityValue& lv)
+std::unique_ptr<AbstractValue> NAryValue::operator+(const InfinityValue& lv) const
 {
     return lv.clone();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator+(NAryValue& nv)
+std::unique_ptr<AbstractValue> NAryValue::operator+(const NAryValue& nv) const
 {
     if (op_ == Operation::Minimum || op_ == Operation::Maximum) {
         list<AV> terms;
@@ -2319,12 +2375,12 @@ std::unique_ptr<AbstractValue> NAryValue::operator+(NAryValue& nv)
     return NAryValue(clone(), nv.clone(), Operation::Addition).evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator+(UndefinedValue &)
+std::unique_ptr<AbstractValue> NAryValue::operator+(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator+(UnaryValue& ov)
+std::unique_ptr<AbstractValue> NAryValue::operator+(const UnaryValue& ov) const
 {
     if ((ov.op_ == SquareRoot) &&
             (op_ == Operation::Minimum || op_ == Operation::Maximum)) {
@@ -2339,49 +2395,49 @@ std::unique_ptr<AbstractValue> NAryValue::operator+(UnaryValue& ov)
     return NAryValue(clone(), ov.clone(), Operation::Addition).evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator-(AbstractValue& av)
+std::unique_ptr<AbstractValue> NAryValue::operator-(const AbstractValue& av) const
 {
     return *this + *timesMinusOne(av);
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator-(IntegerValue& iv)
+std::unique_ptr<AbstractValue> NAryValue::operator-(const IntegerValue& iv) const
 {
     return *this + *timesMinusOne(iv);
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator-(SymbolValue& sv)
+std::unique_ptr<AbstractValue> NAryValue::operator-(const SymbolValue& sv) const
 {
     return *this + *timesMinusOne(*sv.evaluate());
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator-(InfinityValue& lv)
+std::unique_ptr<AbstractValue> NAryValue::operator-(const InfinityValue& lv) const
 {
     if (lv.getSign() == Sign::Positive)
         return std::make_unique<InfinityValue>(Sign::Negative);
     return std::make_unique<InfinityValue>(Sign::Positive);
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator-(NAryValue& lv)
+std::unique_ptr<AbstractValue> NAryValue::operator-(const NAryValue& lv) const
 {
     return *this + *timesMinusOne(lv);
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator-(UndefinedValue &)
+std::unique_ptr<AbstractValue> NAryValue::operator-(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator-(UnaryValue& ov)
+std::unique_ptr<AbstractValue> NAryValue::operator-(const UnaryValue& ov) const
 {
     return *this + *timesMinusOne(ov);
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator*(AbstractValue& av)
+std::unique_ptr<AbstractValue> NAryValue::operator*(const AbstractValue& av) const
 {
     return av * *this;
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator*(IntegerValue& iv)
+std::unique_ptr<AbstractValue> NAryValue::operator*(const IntegerValue& iv) const
 {
     if (iv.getValue() == 0)
         return IntegerValue(0).evaluate();
@@ -2424,18 +2480,18 @@ std::unique_ptr<AbstractValue> NAryValue::operator*(IntegerValue& iv)
     return NAryValue(clone(), iv.clone(), Operation::Multiplication).evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator*(SymbolValue& sv)
+std::unique_ptr<AbstractValue> NAryValue::operator*(const SymbolValue& sv) const
 {
     return *this * *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator*(InfinityValue& lv)
+std::unique_ptr<AbstractValue> NAryValue::operator*(const InfinityValue& lv) const
 {
     alertUndefined(*this, "*", lv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator*(NAryValue& nv)
+std::unique_ptr<AbstractValue> NAryValue::operator*(const NAryValue& nv) const
 {
     if (op_ == Division && nv.op_ == Division) {
         AV n1 = terms_.front()->clone();
@@ -2478,21 +2534,21 @@ std::unique_ptr<AbstractValue> NAryValue::operator*(NAryValue& nv)
     return NAryValue(clone(), nv.clone(), Operation::Multiplication).evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator*(UndefinedValue &)
+std::unique_ptr<AbstractValue> NAryValue::operator*(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator*(UnaryValue& ov)
+std::unique_ptr<AbstractValue> NAryValue::operator*(const UnaryValue& ov) const
 {
     return NAryValue(clone(), ov.clone(), Operation::Multiplication).evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator/(AbstractValue& av)
+std::unique_ptr<AbstractValue> NAryValue::operator/(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = static_cast<IntegerValue&>(av);
+        const IntegerValue& iv = static_cast<const IntegerValue&>(av);
         return (*this / iv);
     }
     case KSymbol: {
@@ -2500,19 +2556,19 @@ std::unique_ptr<AbstractValue> NAryValue::operator/(AbstractValue& av)
         return *this / *sv;
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return *this / lv;
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return *this / nv;
     }
     case KUndefined: {
-        UndefinedValue& uv = static_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = static_cast<const UndefinedValue&>(av);
         return (*this / uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this / ov);
     }
     default:
@@ -2520,12 +2576,12 @@ std::unique_ptr<AbstractValue> NAryValue::operator/(AbstractValue& av)
     }
     r(toString());
     r(av.toString());
-    std::cout << "ERROR: IntegerValue::operator/(AbstractValue& av)" << std::endl;
+    std::cout << "ERROR: IntegerValue::operator/(const AbstractValue& av) const" << std::endl;
     exit(1);
     return nullptr;
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator/(IntegerValue& iv)
+std::unique_ptr<AbstractValue> NAryValue::operator/(const IntegerValue& iv) const
 {
     if (iv.getValue() == 1)
         return clone();
@@ -2545,17 +2601,17 @@ std::unique_ptr<AbstractValue> NAryValue::operator/(IntegerValue& iv)
     return NAryValue(clone(), iv.clone(), Operation::Division).evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator/(SymbolValue& sv)
+std::unique_ptr<AbstractValue> NAryValue::operator/(const SymbolValue& sv) const
 {
     return *this / *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator/(InfinityValue& lv)
+std::unique_ptr<AbstractValue> NAryValue::operator/(const InfinityValue& lv) const
 {
-    std::make_unique<IntegerValue>(0);
+    return std::make_unique<IntegerValue>(0);
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator/(NAryValue& nv)
+std::unique_ptr<AbstractValue> NAryValue::operator/(const NAryValue& nv) const
 {
     if (nv.op_ == Division) {
         AV n = nv.terms_.back()->clone();
@@ -2572,21 +2628,21 @@ std::unique_ptr<AbstractValue> NAryValue::operator/(NAryValue& nv)
     return NAryValue(clone(), nv.clone(), Operation::Division).evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator/(UndefinedValue &)
+std::unique_ptr<AbstractValue> NAryValue::operator/(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator/(UnaryValue& ov)
+std::unique_ptr<AbstractValue> NAryValue::operator/(const UnaryValue& ov) const
 {
     return NAryValue(clone(), ov.clone(), Operation::Division).evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator>>(AbstractValue &av)
+std::unique_ptr<AbstractValue> NAryValue::operator>>(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = dynamic_cast<IntegerValue&>(av);
+        const IntegerValue& iv = dynamic_cast<const IntegerValue&>(av);
         return (*this >> iv);
     }
     case KSymbol: {
@@ -2594,67 +2650,67 @@ std::unique_ptr<AbstractValue> NAryValue::operator>>(AbstractValue &av)
         return (*this >> *sv);
     }
     case KInfinity: {
-        InfinityValue& lv = dynamic_cast<InfinityValue&>(av);
+        const InfinityValue& lv = dynamic_cast<const InfinityValue&>(av);
         return (*this >> lv);
     }
     case KNAry: {
-        NAryValue& nv = dynamic_cast<NAryValue&>(av);
+        const NAryValue& nv = dynamic_cast<const NAryValue&>(av);
         return (*this >> nv);
     }
     case KUndefined: {
-        UndefinedValue& uv = dynamic_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = dynamic_cast<const UndefinedValue&>(av);
         return (*this >> uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this >> ov);
     }
     default:
         break;
     }
-    std::cout << "ERROR: NAryValue::operator>>(AbstractValue &)" << std::endl;
+    std::cout << "ERROR: NAryValue::operator>>(const AbstractValue&) const" << std::endl;
     exit(1);
     return nullptr;
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator>>(IntegerValue &iv)
+std::unique_ptr<AbstractValue> NAryValue::operator>>(const IntegerValue& iv) const
 {
     IntegerValue q(1 << iv.getValue());
 
     return *this / q;
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator>>(SymbolValue &sv)
+std::unique_ptr<AbstractValue> NAryValue::operator>>(const SymbolValue& sv) const
 {
     return *this >> *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator>>(InfinityValue &lv)
+std::unique_ptr<AbstractValue> NAryValue::operator>>(const InfinityValue& lv) const
 {
     alertUndefined(*this, ">>", lv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator>>(NAryValue &nv)
+std::unique_ptr<AbstractValue> NAryValue::operator>>(const NAryValue& nv) const
 {
     return std::make_unique<NAryValue>(clone(), nv.clone(), ShiftRight);
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator>>(UndefinedValue &)
+std::unique_ptr<AbstractValue> NAryValue::operator>>(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator>>(UnaryValue& ov)
+std::unique_ptr<AbstractValue> NAryValue::operator>>(const UnaryValue& ov) const
 {
     return NAryValue(clone(), ov.clone(), Operation::ShiftRight).evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator<<(AbstractValue &av)
+std::unique_ptr<AbstractValue> NAryValue::operator<<(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = dynamic_cast<IntegerValue&>(av);
+        const IntegerValue& iv = dynamic_cast<const IntegerValue&>(av);
         return (*this << iv);
     }
     case KSymbol: {
@@ -2662,83 +2718,83 @@ std::unique_ptr<AbstractValue> NAryValue::operator<<(AbstractValue &av)
         return (*this << *sv);
     }
     case KInfinity: {
-        InfinityValue& lv = dynamic_cast<InfinityValue&>(av);
+        const InfinityValue& lv = dynamic_cast<const InfinityValue&>(av);
         return (*this << lv);
     }
     case KNAry: {
-        NAryValue& nv = dynamic_cast<NAryValue&>(av);
+        const NAryValue& nv = dynamic_cast<const NAryValue&>(av);
         return (*this << nv);
     }
     case KUndefined: {
-        UndefinedValue& uv = dynamic_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = dynamic_cast<const UndefinedValue&>(av);
         return (*this << uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this << ov);
     }
     default:
         break;
     }
-    std::cout << "ERROR: NAryValue::operator<<(AbstractValue &)" << std::endl;
+    std::cout << "ERROR: NAryValue::operator<<(const AbstractValue&) const" << std::endl;
     exit(1);
     return nullptr;
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator<<(IntegerValue &iv)
+std::unique_ptr<AbstractValue> NAryValue::operator<<(const IntegerValue& iv) const
 {
     IntegerValue q(1 << iv.getValue());
 
     return *this * q;
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator<<(SymbolValue &sv)
+std::unique_ptr<AbstractValue> NAryValue::operator<<(const SymbolValue& sv) const
 {
     return *this << *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator<<(InfinityValue &lv)
+std::unique_ptr<AbstractValue> NAryValue::operator<<(const InfinityValue& lv) const
 {
     alertUndefined(*this, "<<", lv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator<<(NAryValue &nv)
+std::unique_ptr<AbstractValue> NAryValue::operator<<(const NAryValue& nv) const
 {
     return std::make_unique<NAryValue>(clone(), nv.clone(), ShiftLeft);
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator<<(UndefinedValue &)
+std::unique_ptr<AbstractValue> NAryValue::operator<<(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> NAryValue::operator<<(UnaryValue& ov)
+std::unique_ptr<AbstractValue> NAryValue::operator<<(const UnaryValue& ov) const
 {
     return NAryValue(clone(), ov.clone(), Operation::ShiftLeft).evaluate();
 }
 
-bool NAryValue::operator==(AbstractValue& av)
+bool NAryValue::operator==(const AbstractValue& av) const
 {
     return av == *this;
 }
 
-bool NAryValue::operator==(IntegerValue &)
+bool NAryValue::operator==(const IntegerValue&) const
 {
     return false;
 }
 
-bool NAryValue::operator==(SymbolValue& sv)
+bool NAryValue::operator==(const SymbolValue& sv) const
 {
     return  sv == *this;
 }
 
-bool NAryValue::operator==(InfinityValue &)
+bool NAryValue::operator==(const InfinityValue&) const
 {
     return false;
 }
 
-bool NAryValue::operator==(NAryValue& lv)
+bool NAryValue::operator==(const NAryValue& lv) const
 {
     if (op_ != lv.op_ || lv.terms_.size() != terms_.size()) {
         return false;
@@ -2765,17 +2821,17 @@ bool NAryValue::operator==(NAryValue& lv)
         return false;
 }
 
-bool NAryValue::operator==(UndefinedValue &)
+bool NAryValue::operator==(const UndefinedValue&) const
 {
     return false;
 }
 
-bool NAryValue::operator==(UnaryValue &)
+bool NAryValue::operator==(const UnaryValue&) const
 {
     return false;
 }
 
-bool NAryValue::operator<(AbstractValue& av)
+bool NAryValue::operator<(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KSymbol: {
@@ -2783,34 +2839,34 @@ bool NAryValue::operator<(AbstractValue& av)
         return *this < *sv;
     }
     case KInteger: {
-        IntegerValue& iv = static_cast<IntegerValue&>(av);
+        const IntegerValue& iv = static_cast<const IntegerValue&>(av);
         return *this < iv;
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return *this < lv;
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return *this < nv;
     }
     case KUndefined: {
-        UndefinedValue& uv = dynamic_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = dynamic_cast<const UndefinedValue&>(av);
         return (*this < uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this < ov);
     }
     default:
-        std::cout << "ERROR: NAryValue::operator<(AbstractValue& av):: bad kind of value!" << std::endl;
+        std::cout << "ERROR: NAryValue::operator<(const AbstractValue& av) const:: bad kind of value!" << std::endl;
         exit(1);
         break;
     }
     return false;
 }
 
-bool NAryValue::operator<(IntegerValue& iv)
+bool NAryValue::operator<(const IntegerValue& iv) const
 {
     if (op_ == Division) {
         if (integerIsGreaterThanNAryDivision(iv, *this) == 1)
@@ -2822,17 +2878,17 @@ bool NAryValue::operator<(IntegerValue& iv)
     return false;
 }
 
-bool NAryValue::operator<(SymbolValue& sv)
+bool NAryValue::operator<(const SymbolValue& sv) const
 {
     return  *this < *sv.evaluate();
 }
 
-bool NAryValue::operator<(InfinityValue& lv)
+bool NAryValue::operator<(const InfinityValue& lv) const
 {
     return lv.getSign() == Sign::Positive;
 }
 
-bool NAryValue::operator<(NAryValue& lv) 
+bool NAryValue::operator<(const NAryValue& lv) const 
 {
     IntegerValue zero(0);
     std::unique_ptr<AbstractValue> aOp1;
@@ -2882,17 +2938,17 @@ bool NAryValue::operator<(NAryValue& lv)
     return false;
 }
 
-bool NAryValue::operator<(UndefinedValue &)
+bool NAryValue::operator<(const UndefinedValue&) const
 {
     return false;
 }
 
-bool NAryValue::operator<(UnaryValue &)
+bool NAryValue::operator<(const UnaryValue&) const
 {
     return false;
 }
 
-bool NAryValue::operator>(AbstractValue& av)
+bool NAryValue::operator>(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KSymbol: {
@@ -2900,35 +2956,35 @@ bool NAryValue::operator>(AbstractValue& av)
         return *this > *sv;
     }
     case KInteger: {
-        IntegerValue& iv = static_cast<IntegerValue&>(av);
+        const IntegerValue& iv = static_cast<const IntegerValue&>(av);
         return *this > iv;
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return *this > lv;
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return *this > nv;
     }
     case KUndefined: {
-        UndefinedValue& uv = static_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = static_cast<const UndefinedValue&>(av);
         return *this > uv;
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return *this > ov;
     }
     default:
         r(av.toString());
-        cout << "ERROR: NAryValue::operator>(AbstractValue& av): bad kind of value!" << endl;
+        cout << "ERROR: NAryValue::operator>(const AbstractValue& av) const: bad kind of value!" << endl;
         exit(1);
         break;
     }
     return false;
 }
 
-bool NAryValue::operator>(IntegerValue& iv)
+bool NAryValue::operator>(const IntegerValue& iv) const
 {
     if (op_ == Division) {
         if (integerIsGreaterThanNAryDivision(iv, *this) == 2)
@@ -2940,17 +2996,17 @@ bool NAryValue::operator>(IntegerValue& iv)
     return false;
 }
 
-bool NAryValue::operator>(SymbolValue& sv)
+bool NAryValue::operator>(const SymbolValue& sv) const
 {
     return  *this > *sv.evaluate();
 }
 
-bool NAryValue::operator>(InfinityValue& lv)
+bool NAryValue::operator>(const InfinityValue& lv) const
 {
     return lv.getSign() == Sign::Negative;
 }
 
-bool NAryValue::operator>(NAryValue& lv)
+bool NAryValue::operator>(const NAryValue& lv) const
 {
     IntegerValue zero(0);
     std::unique_ptr<AbstractValue> aOp1;
@@ -3000,24 +3056,24 @@ bool NAryValue::operator>(NAryValue& lv)
     return false;
 }
 
-bool NAryValue::operator>(UndefinedValue &)
+bool NAryValue::operator>(const UndefinedValue&) const
 {
     return false;
 }
 
-bool NAryValue::operator>(UnaryValue &)
+bool NAryValue::operator>(const UnaryValue&) const
 {
     return false;
 }
 
-bool NAryValue::isDiscrete()
+bool NAryValue::isDiscrete() const
 {
     if (op_ == Modulo || op_ == Minimum || op_ == Maximum)
         return true;
     return false;
 }
 
-bool NAryValue::isShift()
+bool NAryValue::isShift() const
 {
     if (op_ == ShiftRight || op_ == ShiftLeft)
         return true;
@@ -3025,7 +3081,7 @@ bool NAryValue::isShift()
 }
 
 // return true if the NAryValue is a multiplication of 1 by an symbol
-bool NAryValue::isTimesOne()
+bool NAryValue::isTimesOne() const
 {
     if ( (op_ == Multiplication) && (terms_.size() == 2) ) {
         AV aCopy = clone();
@@ -3063,13 +3119,13 @@ std::ostream& operator<<(std::ostream& os, const Range& range)
     return os;
 }
 
-std::unique_ptr<AbstractValue> AbstractValue::operator+(int v)
+std::unique_ptr<AbstractValue> AbstractValue::operator+(int v) const
 {
     IntegerValue iv(v);
     return *this + iv;
 }
 
-std::unique_ptr<AbstractValue> AbstractValue::operator-(int v)
+std::unique_ptr<AbstractValue> AbstractValue::operator-(int v) const
 {
     IntegerValue iv((-1)*v);
     return *this + iv;
@@ -3078,7 +3134,7 @@ std::unique_ptr<AbstractValue> AbstractValue::operator-(int v)
 unsigned Simbol::cnt_ = 0;
 
 Simbol::Simbol(const char* name, CPlusPlus::TranslationUnit* p)
-    : id_(new Identifier(name, sizeof(name)))
+    : id_(new Identifier(name, std::strlen(name)))
     , program_(p)
     , Symbol(program_, cnt_++, id_)
 {
@@ -3745,264 +3801,264 @@ std::unique_ptr<AbstractValue> UndefinedValue::clone() const
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::evaluate()
+std::unique_ptr<AbstractValue> UndefinedValue::evaluate() const
 {
     return clone();
 }
 
-string UndefinedValue::toString()
+string UndefinedValue::toString() const
 {
     return "Undefined";
 }
 
-KindOfValue UndefinedValue::getKindOfValue()
+KindOfValue UndefinedValue::getKindOfValue() const
 {
     return kindOfValue_;
 }
 
-std::set<std::unique_ptr<AbstractValue> > UndefinedValue::asSet()
+std::set<std::unique_ptr<AbstractValue> > UndefinedValue::asSet() const
 {
     std::set<std::unique_ptr<AbstractValue> > s;
     s.insert(clone());
     return s;
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator+(AbstractValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator+(const AbstractValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator+(IntegerValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator+(const IntegerValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator+(SymbolValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator+(const SymbolValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator+(InfinityValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator+(const InfinityValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator+(NAryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator+(const NAryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator+(UndefinedValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator+(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator+(UnaryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator+(const UnaryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator-(AbstractValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator-(const AbstractValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator-(IntegerValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator-(const IntegerValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator-(SymbolValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator-(const SymbolValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator-(InfinityValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator-(const InfinityValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator-(NAryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator-(const NAryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator-(UndefinedValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator-(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator-(UnaryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator-(const UnaryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator*(AbstractValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator*(const AbstractValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator*(IntegerValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator*(const IntegerValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator*(SymbolValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator*(const SymbolValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator*(InfinityValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator*(const InfinityValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator*(NAryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator*(const NAryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator*(UndefinedValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator*(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator*(UnaryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator*(const UnaryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator/(AbstractValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator/(const AbstractValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator/(IntegerValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator/(const IntegerValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator/(SymbolValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator/(const SymbolValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator/(InfinityValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator/(const InfinityValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator/(NAryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator/(const NAryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator/(UndefinedValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator/(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator/(UnaryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator/(const UnaryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator>>(AbstractValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator>>(const AbstractValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator>>(IntegerValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator>>(const IntegerValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator>>(SymbolValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator>>(const SymbolValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator>>(InfinityValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator>>(const InfinityValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator>>(NAryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator>>(const NAryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator>>(UndefinedValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator>>(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator>>(UnaryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator>>(const UnaryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator<<(AbstractValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator<<(const AbstractValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator<<(IntegerValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator<<(const IntegerValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator<<(SymbolValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator<<(const SymbolValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator<<(InfinityValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator<<(const InfinityValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator<<(NAryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator<<(const NAryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator<<(UndefinedValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator<<(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UndefinedValue::operator<<(UnaryValue &)
+std::unique_ptr<AbstractValue> UndefinedValue::operator<<(const UnaryValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> AbstractValue::operator+(UndefinedValue &)
+std::unique_ptr<AbstractValue> AbstractValue::operator+(const UndefinedValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> AbstractValue::operator-(UndefinedValue &)
+std::unique_ptr<AbstractValue> AbstractValue::operator-(const UndefinedValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> AbstractValue::operator*(UndefinedValue &)
+std::unique_ptr<AbstractValue> AbstractValue::operator*(const UndefinedValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> AbstractValue::operator/(UndefinedValue &)
+std::unique_ptr<AbstractValue> AbstractValue::operator/(const UndefinedValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> AbstractValue::operator<<(UndefinedValue &)
+std::unique_ptr<AbstractValue> AbstractValue::operator<<(const UndefinedValue&) const
 {
     return make_unique<UndefinedValue>();
 }
 
-std::unique_ptr<AbstractValue> AbstractValue::operator>>(UndefinedValue &)
+std::unique_ptr<AbstractValue> AbstractValue::operator>>(const UndefinedValue&) const
 {
     return make_unique<UndefinedValue>();
 }
@@ -4014,22 +4070,22 @@ std::unique_ptr<AbstractValue> UnaryValue::clone() const
     return make_unique<UnaryValue>(value_->clone(), op_);
 }
 
-string UnaryValue::toString()
+string UnaryValue::toString() const
 {
     return "sqrt(" + value_->toString() + ")";
 }
 
-string UnaryValue::toCCode()
+string UnaryValue::toCCode() const
 {
     return "msqrt(" + value_->toCCode() + ")";
 }
 
-KindOfValue UnaryValue::getKindOfValue()
+KindOfValue UnaryValue::getKindOfValue() const
 {
     return kindOfValue_;
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::evaluate()
+std::unique_ptr<AbstractValue> UnaryValue::evaluate() const
 {
     AV av = value_->evaluate();
 
@@ -4062,12 +4118,12 @@ std::unique_ptr<AbstractValue> UnaryValue::evaluate()
     return make_unique<UnaryValue>(move(av), op_);
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::develop()
+std::unique_ptr<AbstractValue> UnaryValue::develop() const
 {
     return UnaryValue(value_->develop(), op_).evaluate();
 }
 
-void UnaryValue::buildSymbolDependence()
+void UnaryValue::buildSymbolDependence() const
 {
     symbolDep_.clear();
     value_->buildSymbolDependence();
@@ -4076,7 +4132,7 @@ void UnaryValue::buildSymbolDependence()
     }
 }
 
-std::list<std::unique_ptr<AbstractValue> > UnaryValue::termsClone()
+std::list<std::unique_ptr<AbstractValue> > UnaryValue::termsClone() const
 {
     list<std::unique_ptr<AbstractValue>> l;
     l.push_back(value_->clone());
@@ -4084,34 +4140,34 @@ std::list<std::unique_ptr<AbstractValue> > UnaryValue::termsClone()
     return l;
 }
 
-std::set<std::unique_ptr<AbstractValue> > UnaryValue::asSet()
+std::set<std::unique_ptr<AbstractValue> > UnaryValue::asSet() const
 {
     std::set<std::unique_ptr<AbstractValue> > s;
     s.insert(clone());
     return s;
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator+(AbstractValue& av)
+std::unique_ptr<AbstractValue> UnaryValue::operator+(const AbstractValue& av) const
 {
     return av + *this;
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator+(IntegerValue& iv)
+std::unique_ptr<AbstractValue> UnaryValue::operator+(const IntegerValue& iv) const
 {
     return NAryValue(evaluate(), iv.evaluate(), Operation::Addition).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator+(SymbolValue& sv)
+std::unique_ptr<AbstractValue> UnaryValue::operator+(const SymbolValue& sv) const
 {
     return *this + *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator+(InfinityValue& lv)
+std::unique_ptr<AbstractValue> UnaryValue::operator+(const InfinityValue& lv) const
 {
     return lv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator+(NAryValue& nv)
+std::unique_ptr<AbstractValue> UnaryValue::operator+(const NAryValue& nv) const
 {
     if ((op_ == SquareRoot) &&
             nv.op_ == Operation::Minimum || nv.op_ == Operation::Maximum) {
@@ -4126,93 +4182,93 @@ std::unique_ptr<AbstractValue> UnaryValue::operator+(NAryValue& nv)
     return NAryValue(evaluate(), nv.evaluate(), Operation::Addition).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator+(UndefinedValue &)
+std::unique_ptr<AbstractValue> UnaryValue::operator+(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator+(UnaryValue& ov)
+std::unique_ptr<AbstractValue> UnaryValue::operator+(const UnaryValue& ov) const
 {
     return NAryValue(evaluate(), ov.evaluate(), Operation::Addition).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator-(AbstractValue& av)
+std::unique_ptr<AbstractValue> UnaryValue::operator-(const AbstractValue& av) const
 {
     return *this + *timesMinusOne(av);
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator-(IntegerValue& iv)
+std::unique_ptr<AbstractValue> UnaryValue::operator-(const IntegerValue& iv) const
 {
     return *this + *timesMinusOne(iv);
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator-(SymbolValue& sv)
+std::unique_ptr<AbstractValue> UnaryValue::operator-(const SymbolValue& sv) const
 {
     return *this - *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator-(InfinityValue& lv)
+std::unique_ptr<AbstractValue> UnaryValue::operator-(const InfinityValue& lv) const
 {
     if (lv.getSign() == Positive)
         return InfinityValue(Negative).evaluate();
     return InfinityValue(Positive).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator-(NAryValue& nv)
+std::unique_ptr<AbstractValue> UnaryValue::operator-(const NAryValue& nv) const
 {
     return *this + *timesMinusOne(nv);
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator-(UndefinedValue &)
+std::unique_ptr<AbstractValue> UnaryValue::operator-(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator-(UnaryValue& ov)
+std::unique_ptr<AbstractValue> UnaryValue::operator-(const UnaryValue& ov) const
 {
     return *this + *timesMinusOne(ov);
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator*(AbstractValue& av)
+std::unique_ptr<AbstractValue> UnaryValue::operator*(const AbstractValue& av) const
 {
     return av * *this;
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator*(IntegerValue& iv)
+std::unique_ptr<AbstractValue> UnaryValue::operator*(const IntegerValue& iv) const
 {
     return NAryValue(evaluate(), iv.evaluate(), Operation::Multiplication).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator*(SymbolValue& sv)
+std::unique_ptr<AbstractValue> UnaryValue::operator*(const SymbolValue& sv) const
 {
     return *this * *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator*(InfinityValue& lv)
+std::unique_ptr<AbstractValue> UnaryValue::operator*(const InfinityValue& lv) const
 {
     return lv.clone();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator*(NAryValue& nv)
+std::unique_ptr<AbstractValue> UnaryValue::operator*(const NAryValue& nv) const
 {
     return NAryValue(evaluate(), nv.evaluate(), Operation::Multiplication).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator*(UndefinedValue &)
+std::unique_ptr<AbstractValue> UnaryValue::operator*(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator*(UnaryValue& ov)
+std::unique_ptr<AbstractValue> UnaryValue::operator*(const UnaryValue& ov) const
 {
     return NAryValue(evaluate(), ov.evaluate(), Operation::Multiplication).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator/(AbstractValue& av)
+std::unique_ptr<AbstractValue> UnaryValue::operator/(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = static_cast<IntegerValue&>(av);
+        const IntegerValue& iv = static_cast<const IntegerValue&>(av);
         return (*this / iv);
     }
     case KSymbol: {
@@ -4220,19 +4276,19 @@ std::unique_ptr<AbstractValue> UnaryValue::operator/(AbstractValue& av)
         return *this / *sv;
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return *this / lv;
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return *this / nv;
     }
     case KUndefined: {
-        UndefinedValue& uv = static_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = static_cast<const UndefinedValue&>(av);
         return (*this / uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this / ov);
     }
     default:
@@ -4245,41 +4301,41 @@ std::unique_ptr<AbstractValue> UnaryValue::operator/(AbstractValue& av)
     return nullptr;
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator/(IntegerValue& iv)
+std::unique_ptr<AbstractValue> UnaryValue::operator/(const IntegerValue& iv) const
 {
     return NAryValue(evaluate(), iv.evaluate(), Operation::Division).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator/(SymbolValue& sv)
+std::unique_ptr<AbstractValue> UnaryValue::operator/(const SymbolValue& sv) const
 {
     return *this / *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator/(InfinityValue &)
+std::unique_ptr<AbstractValue> UnaryValue::operator/(const InfinityValue&) const
 {
     return IntegerValue(0).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator/(NAryValue& nv)
+std::unique_ptr<AbstractValue> UnaryValue::operator/(const NAryValue& nv) const
 {
     return NAryValue(evaluate(), nv.evaluate(), Operation::Division).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator/(UndefinedValue &)
+std::unique_ptr<AbstractValue> UnaryValue::operator/(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator/(UnaryValue& ov)
+std::unique_ptr<AbstractValue> UnaryValue::operator/(const UnaryValue& ov) const
 {
     return NAryValue(evaluate(), ov.evaluate(), Operation::Division).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator>>(AbstractValue& av)
+std::unique_ptr<AbstractValue> UnaryValue::operator>>(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = static_cast<IntegerValue&>(av);
+        const IntegerValue& iv = static_cast<const IntegerValue&>(av);
         return (*this >> iv);
     }
     case KSymbol: {
@@ -4287,19 +4343,19 @@ std::unique_ptr<AbstractValue> UnaryValue::operator>>(AbstractValue& av)
         return *this >> *sv;
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return *this >> lv;
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return *this >> nv;
     }
     case KUndefined: {
-        UndefinedValue& uv = static_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = static_cast<const UndefinedValue&>(av);
         return (*this >> uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this >> ov);
     }
     default:
@@ -4312,44 +4368,44 @@ std::unique_ptr<AbstractValue> UnaryValue::operator>>(AbstractValue& av)
     return nullptr;
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator>>(IntegerValue& iv)
+std::unique_ptr<AbstractValue> UnaryValue::operator>>(const IntegerValue& iv) const
 {
     IntegerValue q(1 << iv.getValue());
 
     return *this / q;
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator>>(SymbolValue& sv)
+std::unique_ptr<AbstractValue> UnaryValue::operator>>(const SymbolValue& sv) const
 {
     return *this >> *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator>>(InfinityValue& lv)
+std::unique_ptr<AbstractValue> UnaryValue::operator>>(const InfinityValue& lv) const
 {
     alertUndefined(*this, ">>", lv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator>>(NAryValue& nv)
+std::unique_ptr<AbstractValue> UnaryValue::operator>>(const NAryValue& nv) const
 {
     return NAryValue(evaluate(), nv.evaluate(), Operation::ShiftRight).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator>>(UndefinedValue &)
+std::unique_ptr<AbstractValue> UnaryValue::operator>>(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator>>(UnaryValue& ov)
+std::unique_ptr<AbstractValue> UnaryValue::operator>>(const UnaryValue& ov) const
 {
     return NAryValue(evaluate(), ov.evaluate(), Operation::ShiftRight).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator<<(AbstractValue& av)
+std::unique_ptr<AbstractValue> UnaryValue::operator<<(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = static_cast<IntegerValue&>(av);
+        const IntegerValue& iv = static_cast<const IntegerValue&>(av);
         return (*this << iv);
     }
     case KSymbol: {
@@ -4357,19 +4413,19 @@ std::unique_ptr<AbstractValue> UnaryValue::operator<<(AbstractValue& av)
         return *this << *sv;
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return *this << lv;
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return *this << nv;
     }
     case KUndefined: {
-        UndefinedValue& uv = static_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = static_cast<const UndefinedValue&>(av);
         return (*this << uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this << ov);
     }
     default:
@@ -4382,44 +4438,44 @@ std::unique_ptr<AbstractValue> UnaryValue::operator<<(AbstractValue& av)
     return nullptr;
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator<<(IntegerValue& iv)
+std::unique_ptr<AbstractValue> UnaryValue::operator<<(const IntegerValue& iv) const
 {
     IntegerValue q(1 << iv.getValue());
 
     return *this * q;
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator<<(SymbolValue& sv)
+std::unique_ptr<AbstractValue> UnaryValue::operator<<(const SymbolValue& sv) const
 {
     return *this << *sv.evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator<<(InfinityValue& lv)
+std::unique_ptr<AbstractValue> UnaryValue::operator<<(const InfinityValue& lv) const
 {
     alertUndefined(*this, "<<", lv);
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator<<(NAryValue& nv)
+std::unique_ptr<AbstractValue> UnaryValue::operator<<(const NAryValue& nv) const
 {
     return NAryValue(evaluate(), nv.evaluate(), Operation::ShiftLeft).evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator<<(UndefinedValue &)
+std::unique_ptr<AbstractValue> UnaryValue::operator<<(const UndefinedValue&) const
 {
     return UndefinedValue().evaluate();
 }
 
-std::unique_ptr<AbstractValue> UnaryValue::operator<<(UnaryValue& ov)
+std::unique_ptr<AbstractValue> UnaryValue::operator<<(const UnaryValue& ov) const
 {
     return NAryValue(evaluate(), ov.evaluate(), Operation::ShiftLeft).evaluate();
 }
 
-bool UnaryValue::operator==(AbstractValue& av)
+bool UnaryValue::operator==(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = static_cast<IntegerValue&>(av);
+        const IntegerValue& iv = static_cast<const IntegerValue&>(av);
         return (*this == iv);
     }
     case KSymbol: {
@@ -4427,19 +4483,19 @@ bool UnaryValue::operator==(AbstractValue& av)
         return *this == *sv;
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return *this == lv;
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return *this == nv;
     }
     case KUndefined: {
-        UndefinedValue& uv = static_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = static_cast<const UndefinedValue&>(av);
         return (*this == uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this == ov);
     }
     default:
@@ -4449,32 +4505,32 @@ bool UnaryValue::operator==(AbstractValue& av)
     return false;
 }
 
-bool UnaryValue::operator==(IntegerValue &)
+bool UnaryValue::operator==(const IntegerValue&) const
 {
     return false;
 }
 
-bool UnaryValue::operator==(SymbolValue &)
+bool UnaryValue::operator==(const SymbolValue&) const
 {
     return false;
 }
 
-bool UnaryValue::operator==(InfinityValue &)
+bool UnaryValue::operator==(const InfinityValue&) const
 {
     return false;
 }
 
-bool UnaryValue::operator==(NAryValue &)
+bool UnaryValue::operator==(const NAryValue&) const
 {
     return false;
 }
 
-bool UnaryValue::operator==(UndefinedValue &)
+bool UnaryValue::operator==(const UndefinedValue&) const
 {
     return false;
 }
 
-bool UnaryValue::operator==(UnaryValue& ov)
+bool UnaryValue::operator==(const UnaryValue& ov) const
 {
     if (op_ == ov.op_) {
         if (op_ == SquareRoot)
@@ -4484,11 +4540,11 @@ bool UnaryValue::operator==(UnaryValue& ov)
     return false;
 }
 
-bool UnaryValue::operator<(AbstractValue& av)
+bool UnaryValue::operator<(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = static_cast<IntegerValue&>(av);
+        const IntegerValue& iv = static_cast<const IntegerValue&>(av);
         return (*this < iv);
     }
     case KSymbol: {
@@ -4496,19 +4552,19 @@ bool UnaryValue::operator<(AbstractValue& av)
         return *this < *sv;
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return *this < lv;
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return *this < nv;
     }
     case KUndefined: {
-        UndefinedValue& uv = static_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = static_cast<const UndefinedValue&>(av);
         return *this < uv;
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return *this < ov;
     }
     default:
@@ -4518,7 +4574,7 @@ bool UnaryValue::operator<(AbstractValue& av)
     return false;
 }
 
-bool UnaryValue::operator<(IntegerValue& iv)
+bool UnaryValue::operator<(const IntegerValue& iv) const
 {
     if (op_ == SquareRoot && iv.getValue() < 0)
         return false;
@@ -4526,29 +4582,29 @@ bool UnaryValue::operator<(IntegerValue& iv)
     return false;
 }
 
-bool UnaryValue::operator<(SymbolValue &)
+bool UnaryValue::operator<(const SymbolValue&) const
 {
     return false;
 }
 
-bool UnaryValue::operator<(InfinityValue& lv)
+bool UnaryValue::operator<(const InfinityValue& lv) const
 {
     if (lv.getSign() == Positive)
         return true;
     return false;
 }
 
-bool UnaryValue::operator<(NAryValue &)
+bool UnaryValue::operator<(const NAryValue&) const
 {
     return false;
 }
 
-bool UnaryValue::operator<(UndefinedValue &)
+bool UnaryValue::operator<(const UndefinedValue&) const
 {
     return false;
 }
 
-bool UnaryValue::operator<(UnaryValue& ov)
+bool UnaryValue::operator<(const UnaryValue& ov) const
 {
     if (op_ == ov.op_) {
         if (op_ == Operation::SquareRoot)
@@ -4558,11 +4614,11 @@ bool UnaryValue::operator<(UnaryValue& ov)
     return false;
 }
 
-bool UnaryValue::operator>(AbstractValue& av)
+bool UnaryValue::operator>(const AbstractValue& av) const
 {
     switch (av.getKindOfValue()) {
     case KInteger: {
-        IntegerValue& iv = static_cast<IntegerValue&>(av);
+        const IntegerValue& iv = static_cast<const IntegerValue&>(av);
         return (*this > iv);
     }
     case KSymbol: {
@@ -4570,19 +4626,19 @@ bool UnaryValue::operator>(AbstractValue& av)
         return *this > *sv;
     }
     case KInfinity: {
-        InfinityValue& lv = static_cast<InfinityValue&>(av);
+        const InfinityValue& lv = static_cast<const InfinityValue&>(av);
         return *this > lv;
     }
     case KNAry: {
-        NAryValue& nv = static_cast<NAryValue&>(av);
+        const NAryValue& nv = static_cast<const NAryValue&>(av);
         return *this > nv;
     }
     case KUndefined: {
-        UndefinedValue& uv = static_cast<UndefinedValue&>(av);
+        const UndefinedValue& uv = static_cast<const UndefinedValue&>(av);
         return (*this > uv);
     }
     case KUnary: {
-        UnaryValue& ov = static_cast<UnaryValue&>(av);
+        const UnaryValue& ov = static_cast<const UnaryValue&>(av);
         return (*this > ov);
     }
     default:
@@ -4592,7 +4648,7 @@ bool UnaryValue::operator>(AbstractValue& av)
     return false;
 }
 
-bool UnaryValue::operator>(IntegerValue& iv)
+bool UnaryValue::operator>(const IntegerValue& iv) const
 {
     if (op_ == SquareRoot && iv.getValue() < 0)
         return true;
@@ -4600,29 +4656,29 @@ bool UnaryValue::operator>(IntegerValue& iv)
     return false;
 }
 
-bool UnaryValue::operator>(SymbolValue& sv)
+bool UnaryValue::operator>(const SymbolValue& sv) const
 {
     return false;
 }
 
-bool UnaryValue::operator>(InfinityValue& lv)
+bool UnaryValue::operator>(const InfinityValue& lv) const
 {
     if (lv.getSign() == Negative)
         return true;
     return false;
 }
 
-bool UnaryValue::operator>(NAryValue &)
+bool UnaryValue::operator>(const NAryValue&) const
 {
     return false;
 }
 
-bool UnaryValue::operator>(UndefinedValue &)
+bool UnaryValue::operator>(const UndefinedValue&) const
 {
     return false;
 }
 
-bool UnaryValue::operator>(UnaryValue& ov)
+bool UnaryValue::operator>(const UnaryValue& ov) const
 {
     if (op_ == ov.op_) {
         if (op_ == Operation::SquareRoot)
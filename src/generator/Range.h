@@ -72,14 +72,14 @@ class Range final
 public:
     Range(std::unique_ptr<AbstractValue> lower,
           std::unique_ptr<AbstractValue> upper);
-    Range(const Range&);
+    Range(const Range&) = default;
     Range(Range&&) = default;
-    Range& operator=(const Range&);
+    Range& operator=(const Range&) = default;
     Range& operator=(Range&&) = default;
 
     Range rangeIntersection(Range* rB);
     Range rangeUnion(const Range &rB);
-    Range evaluate();
+    Range evaluate() const;
     bool operator==(const Range& rhs) const;
     bool operator!=(const Range& rhs) const { return !(*this == rhs); }
     bool empty() const;
@@ -91,8 +91,10 @@ public:
     friend std::ostream& operator<<(std::ostream& os, const Range& range);
 
 
-    std::unique_ptr<AbstractValue> lower_;
-    std::unique_ptr<AbstractValue> upper_;
+    //! Canonical nodes of the ValueTable, shared among the Ranges: they
+    //! are never changed once interned.
+    std::shared_ptr<const AbstractValue> lower_;
+    std::shared_ptr<const AbstractValue> upper_;
 private:
     friend class RangeAnalysis;
 };
@@ -109,94 +111,95 @@ public:
     AbstractValue(KindOfValue k) : kindOfValue_(k) {}
     virtual ~AbstractValue() = default;
     virtual std::unique_ptr<AbstractValue> clone() const = 0;
-    virtual std::string toString() = 0;
-    virtual std::string toCCode() { return toString(); }
-    virtual KindOfValue getKindOfValue() = 0;
-    virtual bool sameType(AbstractValue *value) {return getKindOfValue() == value->getKindOfValue();}
-    virtual std::unique_ptr<AbstractValue> evaluate() = 0;
+    virtual std::string toString() const = 0;
+    virtual std::string toCCode() const { return toString(); }
+    virtual KindOfValue getKindOfValue() const = 0;
+    virtual bool sameType(const AbstractValue *value) const {return getKindOfValue() == value->getKindOfValue();}
+    virtual std::unique_ptr<AbstractValue> evaluate() const = 0;
     //! Develop products of NaryValue
-    virtual std::unique_ptr<AbstractValue> develop() = 0;
-    virtual void buildSymbolDependence() { symbolDep_.clear(); }
-    virtual std::list<std::unique_ptr<AbstractValue> > termsClone()
+    virtual std::unique_ptr<AbstractValue> develop() const = 0;
+    virtual void buildSymbolDependence() const { symbolDep_.clear(); }
+    virtual std::list<std::unique_ptr<AbstractValue> > termsClone() const
     // For a correct copy of the terms of a NAryValue from an AbtractValue pointer
         { return std::list<std::unique_ptr<AbstractValue> >();}
-    virtual std::set<std::unique_ptr<AbstractValue> > asSet() = 0; //!< Separate min and max argument into different AV
-
-    virtual std::unique_ptr<AbstractValue> operator+(int);
-    virtual std::unique_ptr<AbstractValue> operator+(AbstractValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator+(IntegerValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator+(SymbolValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator+(InfinityValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator+(NAryValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator+(UndefinedValue&);
-    virtual std::unique_ptr<AbstractValue> operator+(UnaryValue&) {return nullptr;}
-
-    virtual std::unique_ptr<AbstractValue> operator-(int);
-    virtual std::unique_ptr<AbstractValue> operator-(AbstractValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator-(IntegerValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator-(SymbolValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator-(InfinityValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator-(NAryValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator-(UndefinedValue&);
-    virtual std::unique_ptr<AbstractValue> operator-(UnaryValue&) {return nullptr;}
-
-    virtual std::unique_ptr<AbstractValue> operator*(AbstractValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator*(IntegerValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator*(SymbolValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator*(InfinityValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator*(NAryValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator*(UndefinedValue&);
-    virtual std::unique_ptr<AbstractValue> operator*(UnaryValue&) {return nullptr;}
-
-    virtual std::unique_ptr<AbstractValue> operator/(AbstractValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator/(IntegerValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator/(SymbolValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator/(InfinityValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator/(NAryValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator/(UndefinedValue&);
-    virtual std::unique_ptr<AbstractValue> operator/(UnaryValue&) {return nullptr;}
-
-    virtual std::unique_ptr<AbstractValue> operator<<(AbstractValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator<<(IntegerValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator<<(SymbolValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator<<(InfinityValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator<<(NAryValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator<<(UndefinedValue&);
-    virtual std::unique_ptr<AbstractValue> operator<<(UnaryValue&) {return nullptr;}
-
-    virtual std::unique_ptr<AbstractValue> operator>>(AbstractValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator>>(IntegerValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator>>(SymbolValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator>>(InfinityValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator>>(NAryValue&) {return nullptr;}
-    virtual std::unique_ptr<AbstractValue> operator>>(UndefinedValue&);
-    virtual std::unique_ptr<AbstractValue> operator>>(UnaryValue&) {return nullptr;}
-
-    virtual bool operator==(AbstractValue&) {return false;}
-    virtual bool operator==(IntegerValue&) {return false;}
-    virtual bool operator==(SymbolValue&) {return false;}
-    virtual bool operator==(InfinityValue&) {return false;}
-    virtual bool operator==(NAryValue&) {return false;}
-    virtual bool operator==(UndefinedValue&) {return false;}
-    virtual bool operator==(UnaryValue&) {return false;}
-
-    virtual bool operator<(AbstractValue&) {return false;}
-    virtual bool operator<(IntegerValue&) {return false;}
-    virtual bool operator<(SymbolValue&) {return false;}
-    virtual bool operator<(InfinityValue&) {return false;}
-    virtual bool operator<(NAryValue&) {return false;}
-    virtual bool operator<(UndefinedValue&) {return false;}
-    virtual bool operator<(UnaryValue&) {return false;}
-
-    virtual bool operator>(AbstractValue&) {return false;}
-    virtual bool operator>(IntegerValue&) {return false;}
-    virtual bool operator>(SymbolValue&) {return false;}
-    virtual bool operator>(InfinityValue&) {return false;}
-    virtual bool operator>(NAryValue&) {return false;}
-    virtual bool operator>(UndefinedValue&) {return false;}
-    virtual bool operator>(UnaryValue&) {return false;}
-
-    std::set<const CPlusPlus::Symbol*> symbolDep_;
+    virtual std::set<std::unique_ptr<AbstractValue> > asSet() const = 0; //!< Separate min and max argument into different AV
+
+    virtual std::unique_ptr<AbstractValue> operator+(int) const;
+    virtual std::unique_ptr<AbstractValue> operator+(const AbstractValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator+(const IntegerValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator+(const SymbolValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator+(const InfinityValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator+(const NAryValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator+(const UndefinedValue&) const;
+    virtual std::unique_ptr<AbstractValue> operator+(const UnaryValue&) const {return nullptr;}
+
+    virtual std::unique_ptr<AbstractValue> operator-(int) const;
+    virtual std::unique_ptr<AbstractValue> operator-(const AbstractValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator-(const IntegerValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator-(const SymbolValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator-(const InfinityValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator-(const NAryValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator-(const UndefinedValue&) const;
+    virtual std::unique_ptr<AbstractValue> operator-(const UnaryValue&) const {return nullptr;}
+
+    virtual std::unique_ptr<AbstractValue> operator*(const AbstractValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator*(const IntegerValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator*(const SymbolValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator*(const InfinityValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator*(const NAryValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator*(const UndefinedValue&) const;
+    virtual std::unique_ptr<AbstractValue> operator*(const UnaryValue&) const {return nullptr;}
+
+    virtual std::unique_ptr<AbstractValue> operator/(const AbstractValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator/(const IntegerValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator/(const SymbolValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator/(const InfinityValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator/(const NAryValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator/(const UndefinedValue&) const;
+    virtual std::unique_ptr<AbstractValue> operator/(const UnaryValue&) const {return nullptr;}
+
+    virtual std::unique_ptr<AbstractValue> operator<<(const AbstractValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator<<(const IntegerValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator<<(const SymbolValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator<<(const InfinityValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator<<(const NAryValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator<<(const UndefinedValue&) const;
+    virtual std::unique_ptr<AbstractValue> operator<<(const UnaryValue&) const {return nullptr;}
+
+    virtual std::unique_ptr<AbstractValue> operator>>(const AbstractValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator>>(const IntegerValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator>>(const SymbolValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator>>(const InfinityValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator>>(const NAryValue&) const {return nullptr;}
+    virtual std::unique_ptr<AbstractValue> operator>>(const UndefinedValue&) const;
+    virtual std::unique_ptr<AbstractValue> operator>>(const UnaryValue&) const {return nullptr;}
+
+    virtual bool operator==(const AbstractValue&) const {return false;}
+    virtual bool operator==(const IntegerValue&) const {return false;}
+    virtual bool operator==(const SymbolValue&) const {return false;}
+    virtual bool operator==(const InfinityValue&) const {return false;}
+    virtual bool operator==(const NAryValue&) const {return false;}
+    virtual bool operator==(const UndefinedValue&) const {return false;}
+    virtual bool operator==(const UnaryValue&) const {return false;}
+
+    virtual bool operator<(const AbstractValue&) const {return false;}
+    virtual bool operator<(const IntegerValue&) const {return false;}
+    virtual bool operator<(const SymbolValue&) const {return false;}
+    virtual bool operator<(const InfinityValue&) const {return false;}
+    virtual bool operator<(const NAryValue&) const {return false;}
+    virtual bool operator<(const UndefinedValue&) const {return false;}
+    virtual bool operator<(const UnaryValue&) const {return false;}
+
+    virtual bool operator>(const AbstractValue&) const {return false;}
+    virtual bool operator>(const IntegerValue&) const {return false;}
+    virtual bool operator>(const SymbolValue&) const {return false;}
+    virtual bool operator>(const InfinityValue&) const {return false;}
+    virtual bool operator>(const NAryValue&) const {return false;}
+    virtual bool operator>(const UndefinedValue&) const {return false;}
+    virtual bool operator>(const UnaryValue&) const {return false;}
+
+    //! Cache of buildSymbolDependence, so the shared bounds can fill it
+    mutable std::set<const CPlusPlus::Symbol*> symbolDep_;
     KindOfValue kindOfValue_;
 
 protected:
@@ -212,85 +215,85 @@ public:
 
     std::unique_ptr<AbstractValue> clone() const override;
     //Bound evaluate() override { return Bound(value_); }
-    std::unique_ptr<AbstractValue> evaluate() override;
-    std::unique_ptr<AbstractValue> develop() override
+    std::unique_ptr<AbstractValue> evaluate() const override;
+    std::unique_ptr<AbstractValue> develop() const override
         { return clone(); }
-    std::string toString() override;
-    KindOfValue getKindOfValue() override;
-    int64_t getValue();
-    std::set<std::unique_ptr<AbstractValue> > asSet() override;
-
-    std::unique_ptr<AbstractValue> operator+(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator+(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator+(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator+(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator+(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator-(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator-(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator-(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator-(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator-(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator*(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator*(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator*(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator*(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator*(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator/(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator/(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator/(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator/(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator/(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator>>(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator<<(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UnaryValue&) override;
-
-    bool operator==(AbstractValue&) override;
-    bool operator==(IntegerValue&) override;
-    bool operator==(SymbolValue&) override;
-    bool operator==(InfinityValue&) override;
-    bool operator==(NAryValue&) override;
-    bool operator==(UndefinedValue&) override;
-    bool operator==(UnaryValue&) override;
-
-    bool operator<(AbstractValue&) override;
-    bool operator<(IntegerValue&) override;
-    bool operator<(SymbolValue&) override;
-    bool operator<(InfinityValue&) override;
-    bool operator<(NAryValue&) override;
-    bool operator<(UndefinedValue&) override;
-    bool operator<(UnaryValue&) override;
-
-    bool operator>(AbstractValue&) override;
-    bool operator>(IntegerValue&) override;
-    bool operator>(SymbolValue&) override;
-    bool operator>(InfinityValue&) override;
-    bool operator>(NAryValue&) override;
-    bool operator>(UndefinedValue&) override;
-    bool operator>(UnaryValue&) override;
+    std::string toString() const override;
+    KindOfValue getKindOfValue() const override;
+    int64_t getValue() const;
+    std::set<std::unique_ptr<AbstractValue> > asSet() const override;
+
+    std::unique_ptr<AbstractValue> operator+(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator-(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator*(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator/(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator>>(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator<<(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UnaryValue&) const override;
+
+    bool operator==(const AbstractValue&) const override;
+    bool operator==(const IntegerValue&) const override;
+    bool operator==(const SymbolValue&) const override;
+    bool operator==(const InfinityValue&) const override;
+    bool operator==(const NAryValue&) const override;
+    bool operator==(const UndefinedValue&) const override;
+    bool operator==(const UnaryValue&) const override;
+
+    bool operator<(const AbstractValue&) const override;
+    bool operator<(const IntegerValue&) const override;
+    bool operator<(const SymbolValue&) const override;
+    bool operator<(const InfinityValue&) const override;
+    bool operator<(const NAryValue&) const override;
+    bool operator<(const UndefinedValue&) const override;
+    bool operator<(const UnaryValue&) const override;
+
+    bool operator>(const AbstractValue&) const override;
+    bool operator>(const IntegerValue&) const override;
+    bool operator>(const SymbolValue&) const override;
+    bool operator>(const InfinityValue&) const override;
+    bool operator>(const NAryValue&) const override;
+    bool operator>(const UndefinedValue&) const override;
+    bool operator>(const UnaryValue&) const override;
 
 private:
     int64_t value_;
@@ -306,85 +309,86 @@ public:
 
     std::unique_ptr<AbstractValue> clone() const override;
     //Bound evaluate() override;
-    std::unique_ptr<AbstractValue> evaluate() override;
-    std::unique_ptr<AbstractValue> develop() override
+    std::unique_ptr<AbstractValue> evaluate() const override;
+    std::unique_ptr<AbstractValue> develop() const override
         { return clone(); }
-    std::string toString() override;
-    KindOfValue getKindOfValue() override;
-    void buildSymbolDependence() override;
-    std::set<std::unique_ptr<AbstractValue> > asSet() override;
-
-    std::unique_ptr<AbstractValue> operator+(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator+(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator+(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator+(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator+(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator-(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator-(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator-(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator-(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator-(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator*(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator*(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator*(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator*(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator*(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator/(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator/(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator/(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator/(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator/(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator>>(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator<<(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UnaryValue&) override;
-
-    bool operator==(AbstractValue&) override;
-    bool operator==(IntegerValue&) override;
-    bool operator==(SymbolValue&) override;
-    bool operator==(InfinityValue&) override;
-    bool operator==(NAryValue&) override;
-    bool operator==(UndefinedValue&) override;
-    bool operator==(UnaryValue&) override;
-
-    bool operator<(AbstractValue&) override;
-    bool operator<(IntegerValue&) override;
-    bool operator<(SymbolValue&) override;
-    bool operator<(InfinityValue&) override;
-    bool operator<(NAryValue&) override;
-    bool operator<(UndefinedValue&) override;
-    bool operator<(UnaryValue&) override;
-
-    bool operator>(AbstractValue&) override;
-    bool operator>(IntegerValue&) override;
-    bool operator>(SymbolValue&) override;
-    bool operator>(InfinityValue&) override;
-    bool operator>(NAryValue&) override;
-    bool operator>(UndefinedValue&) override;
-    bool operator>(UnaryValue&) override;
+    std::string toString() const override;
+    KindOfValue getKindOfValue() const override;
+    const CPlusPlus::Symbol* getSymbol() const { return symbol_; }
+    void buildSymbolDependence() const override;
+    std::set<std::unique_ptr<AbstractValue> > asSet() const override;
+
+    std::unique_ptr<AbstractValue> operator+(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator-(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator*(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator/(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator>>(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator<<(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UnaryValue&) const override;
+
+    bool operator==(const AbstractValue&) const override;
+    bool operator==(const IntegerValue&) const override;
+    bool operator==(const SymbolValue&) const override;
+    bool operator==(const InfinityValue&) const override;
+    bool operator==(const NAryValue&) const override;
+    bool operator==(const UndefinedValue&) const override;
+    bool operator==(const UnaryValue&) const override;
+
+    bool operator<(const AbstractValue&) const override;
+    bool operator<(const IntegerValue&) const override;
+    bool operator<(const SymbolValue&) const override;
+    bool operator<(const InfinityValue&) const override;
+    bool operator<(const NAryValue&) const override;
+    bool operator<(const UndefinedValue&) const override;
+    bool operator<(const UnaryValue&) const override;
+
+    bool operator>(const AbstractValue&) const override;
+    bool operator>(const IntegerValue&) const override;
+    bool operator>(const SymbolValue&) const override;
+    bool operator>(const InfinityValue&) const override;
+    bool operator>(const NAryValue&) const override;
+    bool operator>(const UndefinedValue&) const override;
+    bool operator>(const UnaryValue&) const override;
 
 private:
     const CPlusPlus::Symbol* symbol_;
@@ -418,85 +422,85 @@ public:
     {}
 
     std::unique_ptr<AbstractValue> clone() const override;
-    std::unique_ptr<AbstractValue> evaluate() override;
-    std::unique_ptr<AbstractValue> develop() override
+    std::unique_ptr<AbstractValue> evaluate() const override;
+    std::unique_ptr<AbstractValue> develop() const override
         { return clone(); }
-    std::string toString() override;
-    KindOfValue getKindOfValue() override;
-    Sign getSign();
-    std::set<std::unique_ptr<AbstractValue> > asSet() override;
-
-    std::unique_ptr<AbstractValue> operator+(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator+(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator+(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator+(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator+(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator-(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator-(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator-(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator-(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator-(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator*(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator*(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator*(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator*(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator*(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator/(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator/(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator/(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator/(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator/(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator>>(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator<<(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UnaryValue&) override;
-
-    bool operator==(AbstractValue&) override;
-    bool operator==(IntegerValue&) override;
-    bool operator==(SymbolValue&) override;
-    bool operator==(InfinityValue&) override;
-    bool operator==(NAryValue&) override;
-    bool operator==(UndefinedValue&) override;
-    bool operator==(UnaryValue&) override;
-
-    bool operator<(AbstractValue&) override;
-    bool operator<(IntegerValue&) override;
-    bool operator<(SymbolValue&) override;
-    bool operator<(InfinityValue&) override;
-    bool operator<(NAryValue&) override;
-    bool operator<(UndefinedValue&) override;
-    bool operator<(UnaryValue&) override;
-
-    bool operator>(AbstractValue&) override;
-    bool operator>(IntegerValue&) override;
-    bool operator>(SymbolValue&) override;
-    bool operator>(InfinityValue&) override;
-    bool operator>(NAryValue&) override;
-    bool operator>(UndefinedValue&) override;
-    bool operator>(UnaryValue&) override;
+    std::string toString() const override;
+    KindOfValue getKindOfValue() const override;
+    Sign getSign() const;
+    std::set<std::unique_ptr<AbstractValue> > asSet() const override;
+
+    std::unique_ptr<AbstractValue> operator+(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator-(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator*(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator/(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator>>(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator<<(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UnaryValue&) const override;
+
+    bool operator==(const AbstractValue&) const override;
+    bool operator==(const IntegerValue&) const override;
+    bool operator==(const SymbolValue&) const override;
+    bool operator==(const InfinityValue&) const override;
+    bool operator==(const NAryValue&) const override;
+    bool operator==(const UndefinedValue&) const override;
+    bool operator==(const UnaryValue&) const override;
+
+    bool operator<(const AbstractValue&) const override;
+    bool operator<(const IntegerValue&) const override;
+    bool operator<(const SymbolValue&) const override;
+    bool operator<(const InfinityValue&) const override;
+    bool operator<(const NAryValue&) const override;
+    bool operator<(const UndefinedValue&) const override;
+    bool operator<(const UnaryValue&) const override;
+
+    bool operator>(const AbstractValue&) const override;
+    bool operator>(const IntegerValue&) const override;
+    bool operator>(const SymbolValue&) const override;
+    bool operator>(const InfinityValue&) const override;
+    bool operator>(const NAryValue&) const override;
+    bool operator>(const UndefinedValue&) const override;
+    bool operator>(const UnaryValue&) const override;
 
 private:
     Sign sign_;
@@ -516,17 +520,17 @@ public:
     NAryValue(std::list<std::unique_ptr<AbstractValue> >& terms,
               Operation op);
 
-    std::unique_ptr<AbstractValue> evaluate() override; // _EVAL ***************************************
-    std::unique_ptr<AbstractValue> develop() override;
+    std::unique_ptr<AbstractValue> evaluate() const override; // _EVAL ***************************************
+    std::unique_ptr<AbstractValue> develop() const override;
 
     std::unique_ptr<AbstractValue> clone() const override;
-    std::list<std::unique_ptr<AbstractValue> > termsClone() override;
-    std::string toString() override;
+    std::list<std::unique_ptr<AbstractValue> > termsClone() const override;
+    std::string toString() const override;
     // In C Code, min and max must include the number of operands
-    std::string toCCode() override;
-    KindOfValue getKindOfValue() override;
-    void buildSymbolDependence() override;
-    std::set<std::unique_ptr<AbstractValue> > asSet() override;
+    std::string toCCode() const override;
+    KindOfValue getKindOfValue() const override;
+    void buildSymbolDependence() const override;
+    std::set<std::unique_ptr<AbstractValue> > asSet() const override;
 
     void add(std::unique_ptr<AbstractValue> v); // _ADD
 
@@ -562,85 +566,93 @@ public:
     void removeTimesOne();
     void removeSumToZero();
 
-    std::unique_ptr<AbstractValue> operator+(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator+(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator+(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator+(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator+(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator-(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator-(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator-(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator-(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator-(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator*(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator*(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator*(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator*(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator*(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator/(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator/(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator/(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator/(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator/(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator>>(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator<<(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UnaryValue&) override;
-
-    bool operator==(AbstractValue&) override;
-    bool operator==(IntegerValue&) override;
-    bool operator==(SymbolValue&) override;
-    bool operator==(InfinityValue&) override;
-    bool operator==(NAryValue&) override;
-    bool operator==(UndefinedValue&) override;
-    bool operator==(UnaryValue&) override;
-
-    bool operator<(AbstractValue&) override;
-    bool operator<(IntegerValue&) override;
-    bool operator<(SymbolValue&) override;
-    bool operator<(InfinityValue&) override;
-    bool operator<(NAryValue&) override;
-    bool operator<(UndefinedValue&) override;
-    bool operator<(UnaryValue&) override;
-
-    bool operator>(AbstractValue&) override;
-    bool operator>(IntegerValue&) override;
-    bool operator>(SymbolValue&) override;
-    bool operator>(InfinityValue&) override;
-    bool operator>(NAryValue&) override;
-    bool operator>(UndefinedValue&) override;
-    bool operator>(UnaryValue&) override;
-
-    bool isDiscrete();
-    bool isShift();
-    bool isTimesOne();
+    std::unique_ptr<AbstractValue> operator+(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator-(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator*(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator/(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator>>(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator<<(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UnaryValue&) const override;
+
+    bool operator==(const AbstractValue&) const override;
+    bool operator==(const IntegerValue&) const override;
+    bool operator==(const SymbolValue&) const override;
+    bool operator==(const InfinityValue&) const override;
+    bool operator==(const NAryValue&) const override;
+    bool operator==(const UndefinedValue&) const override;
+    bool operator==(const UnaryValue&) const override;
+
+    bool operator<(const AbstractValue&) const override;
+    bool operator<(const IntegerValue&) const override;
+    bool operator<(const SymbolValue&) const override;
+    bool operator<(const InfinityValue&) const override;
+    bool operator<(const NAryValue&) const override;
+    bool operator<(const UndefinedValue&) const override;
+    bool operator<(const UnaryValue&) const override;
+
+    bool operator>(const AbstractValue&) const override;
+    bool operator>(const IntegerValue&) const override;
+    bool operator>(const SymbolValue&) const override;
+    bool operator>(const InfinityValue&) const override;
+    bool operator>(const NAryValue&) const override;
+    bool operator>(const UndefinedValue&) const override;
+    bool operator>(const UnaryValue&) const override;
+
+    bool isDiscrete() const;
+    bool isShift() const;
+    bool isTimesOne() const;
 
     std::list<std::unique_ptr<AbstractValue> > terms_;
     //KindOfValue kindOfValue_;
     Operation op_;
+
+private:
+    //! toString and toCCode, once the terms are simplified
+    std::string termsToString() const;
+    std::string termsToCCode() const;
+    // The uncached evaluate and develop; see ValueTable.
+    std::unique_ptr<AbstractValue> evaluateUncached() const;
+    std::unique_ptr<AbstractValue> developUncached() const;
 };
 
 class UndefinedValue final : public AbstractValue
@@ -650,84 +662,84 @@ public:
         : AbstractValue(KUndefined) {}
 
     std::unique_ptr<AbstractValue> clone() const override;
-    std::unique_ptr<AbstractValue> evaluate() override;
-    std::unique_ptr<AbstractValue> develop() override
+    std::unique_ptr<AbstractValue> evaluate() const override;
+    std::unique_ptr<AbstractValue> develop() const override
         { return clone(); }
-    std::string toString() override;
-    KindOfValue getKindOfValue() override;
-    std::set<std::unique_ptr<AbstractValue> > asSet() override;
-
-    std::unique_ptr<AbstractValue> operator+(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator+(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator+(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator+(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator+(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator-(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator-(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator-(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator-(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator-(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator*(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator*(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator*(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator*(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator*(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator/(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator/(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator/(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator/(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator/(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator>>(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator<<(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UnaryValue&) override;
-
-    bool operator==(AbstractValue&) {return false;}
-    bool operator==(IntegerValue&) {return false;}
-    bool operator==(SymbolValue&) {return false;}
-    bool operator==(InfinityValue&) {return false;}
-    bool operator==(NAryValue&) {return false;}
-    bool operator==(UndefinedValue&) {return false;}
-    bool operator==(UnaryValue&) {return false;}
-
-    bool operator<(AbstractValue&) {return false;}
-    bool operator<(IntegerValue&) {return false;}
-    bool operator<(SymbolValue&) {return false;}
-    bool operator<(InfinityValue&) {return false;}
-    bool operator<(NAryValue&) {return false;}
-    bool operator<(UndefinedValue&) {return false;}
-    bool operator<(UnaryValue&) {return false;}
-
-    bool operator>(AbstractValue&) {return false;}
-    bool operator>(IntegerValue&) {return false;}
-    bool operator>(SymbolValue&) {return false;}
-    bool operator>(InfinityValue&) {return false;}
-    bool operator>(NAryValue&) {return false;}
-    bool operator>(UndefinedValue&) {return false;}
-    bool operator>(UnaryValue&) {return false;}
+    std::string toString() const override;
+    KindOfValue getKindOfValue() const override;
+    std::set<std::unique_ptr<AbstractValue> > asSet() const override;
+
+    std::unique_ptr<AbstractValue> operator+(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator-(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator*(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator/(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator>>(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator<<(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UnaryValue&) const override;
+
+    bool operator==(const AbstractValue&) const {return false;}
+    bool operator==(const IntegerValue&) const {return false;}
+    bool operator==(const SymbolValue&) const {return false;}
+    bool operator==(const InfinityValue&) const {return false;}
+    bool operator==(const NAryValue&) const {return false;}
+    bool operator==(const UndefinedValue&) const {return false;}
+    bool operator==(const UnaryValue&) const {return false;}
+
+    bool operator<(const AbstractValue&) const {return false;}
+    bool operator<(const IntegerValue&) const {return false;}
+    bool operator<(const SymbolValue&) const {return false;}
+    bool operator<(const InfinityValue&) const {return false;}
+    bool operator<(const NAryValue&) const {return false;}
+    bool operator<(const UndefinedValue&) const {return false;}
+    bool operator<(const UnaryValue&) const {return false;}
+
+    bool operator>(const AbstractValue&) const {return false;}
+    bool operator>(const IntegerValue&) const {return false;}
+    bool operator>(const SymbolValue&) const {return false;}
+    bool operator>(const InfinityValue&) const {return false;}
+    bool operator>(const NAryValue&) const {return false;}
+    bool operator>(const UndefinedValue&) const {return false;}
+    bool operator>(const UnaryValue&) const {return false;}
 };
 
 class UnaryValue final : public AbstractValue
@@ -738,86 +750,86 @@ public:
         AbstractValue(KUnary), value_(std::move(value)), op_(op) {}
 
     virtual std::unique_ptr<AbstractValue> clone() const override;
-    virtual std::string toString() override;
-    virtual std::string toCCode() override;
-    virtual KindOfValue getKindOfValue() override;
-    virtual std::unique_ptr<AbstractValue> evaluate() override;
-    virtual std::unique_ptr<AbstractValue> develop() override;
-    virtual void buildSymbolDependence() override;
-    virtual std::list<std::unique_ptr<AbstractValue> > termsClone() override;
-    virtual std::set<std::unique_ptr<AbstractValue> > asSet() override;
-
-    std::unique_ptr<AbstractValue> operator+(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator+(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator+(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator+(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator+(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator+(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator-(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator-(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator-(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator-(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator-(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator-(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator*(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator*(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator*(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator*(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator*(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator*(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator/(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator/(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator/(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator/(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator/(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator/(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator>>(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator>>(UnaryValue&) override;
-
-    std::unique_ptr<AbstractValue> operator<<(AbstractValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(IntegerValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(SymbolValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(InfinityValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(NAryValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UndefinedValue&) override;
-    std::unique_ptr<AbstractValue> operator<<(UnaryValue&) override;
-
-    bool operator==(AbstractValue&) override;
-    bool operator==(IntegerValue&) override;
-    bool operator==(SymbolValue&) override;
-    bool operator==(InfinityValue&) override;
-    bool operator==(NAryValue&) override;
-    bool operator==(UndefinedValue&) override;
-    bool operator==(UnaryValue&) override;
-
-    bool operator<(AbstractValue&) override;
-    bool operator<(IntegerValue&) override;
-    bool operator<(SymbolValue&) override;
-    bool operator<(InfinityValue&) override;
-    bool operator<(NAryValue&) override;
-    bool operator<(UndefinedValue&) override;
-    bool operator<(UnaryValue&) override;
-
-    bool operator>(AbstractValue&) override;
-    bool operator>(IntegerValue&) override;
-    bool operator>(SymbolValue&) override;
-    bool operator>(InfinityValue&) override;
-    bool operator>(NAryValue&) override;
-    bool operator>(UndefinedValue&) override;
-    bool operator>(UnaryValue&) override;
+    virtual std::string toString() const override;
+    virtual std::string toCCode() const override;
+    virtual KindOfValue getKindOfValue() const override;
+    virtual std::unique_ptr<AbstractValue> evaluate() const override;
+    virtual std::unique_ptr<AbstractValue> develop() const override;
+    virtual void buildSymbolDependence() const override;
+    virtual std::list<std::unique_ptr<AbstractValue> > termsClone() const override;
+    virtual std::set<std::unique_ptr<AbstractValue> > asSet() const override;
+
+    std::unique_ptr<AbstractValue> operator+(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator+(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator-(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator-(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator*(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator*(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator/(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator/(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator>>(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator>>(const UnaryValue&) const override;
+
+    std::unique_ptr<AbstractValue> operator<<(const AbstractValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const IntegerValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const SymbolValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const InfinityValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const NAryValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UndefinedValue&) const override;
+    std::unique_ptr<AbstractValue> operator<<(const UnaryValue&) const override;
+
+    bool operator==(const AbstractValue&) const override;
+    bool operator==(const IntegerValue&) const override;
+    bool operator==(const SymbolValue&) const override;
+    bool operator==(const InfinityValue&) const override;
+    bool operator==(const NAryValue&) const override;
+    bool operator==(const UndefinedValue&) const override;
+    bool operator==(const UnaryValue&) const override;
+
+    bool operator<(const AbstractValue&) const override;
+    bool operator<(const IntegerValue&) const override;
+    bool operator<(const SymbolValue&) const override;
+    bool operator<(const InfinityValue&) const override;
+    bool operator<(const NAryValue&) const override;
+    bool operator<(const UndefinedValue&) const override;
+    bool operator<(const UnaryValue&) const override;
+
+    bool operator>(const AbstractValue&) const override;
+    bool operator>(const IntegerValue&) const override;
+    bool operator>(const SymbolValue&) const override;
+    bool operator>(const InfinityValue&) const override;
+    bool operator>(const NAryValue&) const override;
+    bool operator>(const UndefinedValue&) const override;
+    bool operator>(const UnaryValue&) const override;
 
     std::unique_ptr<AbstractValue> value_;
     Operation op_;
@@ -28,7 +28,11 @@
 #include "Symbols.h"
 #include "TranslationUnit.h"
 #include "Utils.h"
+#include "ValueTable.h"
+#include <algorithm>
+#include <cerrno>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <set>
 
@@ -38,13 +42,53 @@ using namespace CPlusPlus;
 using namespace psyche;
 using namespace std;
 
+namespace {
+
+/*!
+ * \brief integerLiteral
+ *
+ * The value of an integer literal (decimal, octal or hexadecimal, with
+ * u/l suffixes). False for a floating literal (2.5f, 1e3, 0x1p3) and for a
+ * value that doesn't fit an int64_t.
+ */
+bool integerLiteral(const char* chars, int64_t& value)
+{
+    char* end = nullptr;
+    errno = 0;
+    const long long parsed = std::strtoll(chars, &end, 0);
+    if (end == chars || errno == ERANGE)
+        return false;
+    for (; *end; ++end) {
+        if (!std::strchr("uUlL", *end))
+            return false;
+    }
+    value = parsed;
+    return true;
+}
+
+} // anonymous
+
 RangeAnalysis::RangeAnalysis(TranslationUnit *unit)
     : ASTVisitor(unit),
+      maxLoopIterations_(8),
+      narrowingPasses_(1),
       unit_(unit)
 {}
 
-void RangeAnalysis::run(TranslationUnitAST *ast, Namespace *global)
+void RangeAnalysis::setLoopOptions(unsigned int maxIterations,
+                                   unsigned int narrowingPasses)
 {
+    maxLoopIterations_ = std::max(1u, maxIterations);
+    narrowingPasses_ = narrowingPasses;
+}
+
+void RangeAnalysis::run(TranslationUnitAST *ast, Namespace *global,
+                        FunctionDefinitionAST *function)
+{
+    // The symbols of a former program may live at the same addresses as ours,
+    // don't let its cached values be taken as our own.
+    ValueTable::instance().clear();
+
     // initialization variables
     savingStateEnable_ = true;
     arrayAccessDepth_ = 0;
@@ -52,8 +96,13 @@ void RangeAnalysis::run(TranslationUnitAST *ast, Namespace *global)
     parameterScop_ = true;  // local variables should not be initialized... just global, and parameters...
 
     switchScope(global);
-    for (DeclarationListAST *it = ast->declaration_list; it; it = it->next)
+    for (DeclarationListAST *it = ast->declaration_list; it; it = it->next) {
+        if (function && it->value->asFunctionDefinition() && it->value != function)
+            continue;
         accept(it->value);
+        if (it->value == function)
+            break;
+    }
 
     if (debugVisit) {
         printResult();
@@ -140,13 +189,35 @@ void RangeAnalysis::resolve(const Name *name)
 
 void RangeAnalysis::saveState(const CPlusPlus::StatementAST* stmt)
 {
-    for (auto it : rangeMap_) {
-        rangeAnalysis_[stmt].push_back(std::make_pair(it.first, it.second));
-    }
-
+    rangeAnalysis_[stmt] = rangeMap_.snapshot();
     statementsOrder_.push_back(stmt);
 }
 
+const Range* RangeAnalysis::rangeAt(const StatementAST* stmt, const Symbol* symbol) const
+{
+    auto state = rangeAnalysis_.find(stmt);
+    if (state == rangeAnalysis_.end())
+        return nullptr;
+
+    auto it = state->second.find(symbol);
+    if (it == state->second.end())
+        return nullptr;
+    return &it->second;
+}
+
+void RangeAnalysis::printLoopStats()
+{
+    unsigned line;
+    for (auto const& it : loopStats_) {
+        translationUnit()->getTokenPosition(it.first->firstToken(), &line);
+        std::cout << "  Loop at line " << line << ": "
+                  << it.second.visits_ << " visit(s), "
+                  << it.second.iterations_ << " iteration(s), "
+                  << it.second.narrowedBounds_ << " narrowed bound(s)"
+                  << std::endl;
+    }
+}
+
 void RangeAnalysis::printResult()
 {
     unsigned line;
@@ -403,13 +474,16 @@ bool RangeAnalysis::visit(ArrayAccessAST *ast)
 
     currentArrayAccessIndex_++;
 
-    insertAccessToPointer(sym, currentArrayAccessIndex_, ast->expression, enclosingStmt_);
+    // The accesses are only recorded by the visit that saves the state: the
+    // ones that probe a loop see ranges that aren't final.
+    if (savingStateEnable_)
+        insertAccessToPointer(sym, currentArrayAccessIndex_, ast->expression, enclosingStmt_);
 
     accept(ast->expression);
 
     auto it = arrayInfoMap_.find(currentArrayIdentifierSymbol_);
 
-    if (it != arrayInfoMap_.end()) {
+    if (savingStateEnable_ && it != arrayInfoMap_.end()) {
         it->second.addRange(currentArrayAccessIndex_, stack_.top());
     }
 
@@ -514,6 +588,21 @@ bool RangeAnalysis::visit(FunctionDefinitionAST *ast)
     Function* func = ast->symbol;
     const Scope *previousScope = switchScope(func->asScope());
 
+    // The integer constants of the function are widening thresholds of its
+    // loops.
+    functionConstants_.clear();
+    for (unsigned tk = ast->firstToken(); tk < ast->lastToken(); ++tk) {
+        int64_t value;
+        if (tokenKind(tk) == T_NUMERIC_LITERAL
+                && integerLiteral(numericLiteral(tk)->chars(), value)) {
+            functionConstants_.push_back(value);
+        }
+    }
+    std::sort(functionConstants_.begin(), functionConstants_.end());
+    functionConstants_.erase(std::unique(functionConstants_.begin(),
+                                         functionConstants_.end()),
+                             functionConstants_.end());
+
     accept(ast->declarator->asDeclarator());
     parameterScop_ = false; // local variables should not be initialized
     visitStatement(ast->function_body);
@@ -649,7 +738,7 @@ bool RangeAnalysis::visit(IdExpressionAST *ast)
 void RangeAnalysis::checkForPointerDefinition(ExpressionAST *ast)
 {
     auto pointerIsArrayIt = pointerIsArray_.find(symbol_);
-    if (pointerIsArrayIt != pointerIsArray_.end() &&
+    if (savingStateEnable_ && pointerIsArrayIt != pointerIsArray_.end() &&
             pointerIsArrayIt->second == true)  { // collect all the asingnments to pointers
         insertDefinitionToPointer(symbol_, ast, enclosingStmt_);
     }
@@ -881,7 +970,7 @@ bool RangeAnalysis::visit(ConditionalExpressionAST *ast)
             Range rangeLeft(stack_.top());
             stack_.pop();
 
-            VersionedMap<const CPlusPlus::Symbol*, Range> ifTrueRangeMap(rangeMap_);
+            RangeMap::Snapshot ifTrueRangeMap(rangeMap_.snapshot());
 
             rangeMap_.applyRevision(revision);
 
@@ -895,11 +984,11 @@ bool RangeAnalysis::visit(ConditionalExpressionAST *ast)
             Range rangeRight(stack_.top());
             stack_.pop();
 
-            VersionedMap<const CPlusPlus::Symbol*, Range> ifFalseRangeMap(rangeMap_);
+            RangeMap::Snapshot ifFalseRangeMap(rangeMap_.snapshot());
 
             rangeMap_.applyRevision(revision);
 
-            mapUnion(&ifTrueRangeMap, &ifFalseRangeMap);
+            mapUnion(ifTrueRangeMap, ifFalseRangeMap);
             stack_.push(rangeLeft.rangeUnion(rangeRight));
 
             return false;
@@ -912,15 +1001,15 @@ bool RangeAnalysis::visit(ConditionalExpressionAST *ast)
     accept(ast->left_expression);
     Range rangeLeft(stack_.top());
     stack_.pop();
-    VersionedMap<const CPlusPlus::Symbol*, Range> ifRangeMap(rangeMap_);
+    RangeMap::Snapshot ifRangeMap(rangeMap_.snapshot());
     rangeMap_.applyRevision(revision);
     accept(ast->right_expression);
     Range rangeRight(stack_.top());
     stack_.pop();
-    VersionedMap<const CPlusPlus::Symbol*, Range> elseRangeMap(rangeMap_);
+    RangeMap::Snapshot elseRangeMap(rangeMap_.snapshot());
     rangeMap_.applyRevision(revision);
 
-    mapUnion(&ifRangeMap, &elseRangeMap);
+    mapUnion(ifRangeMap, elseRangeMap);
     stack_.push(rangeLeft.rangeUnion(rangeRight));
 
     return false;
@@ -987,44 +1076,32 @@ bool RangeAnalysis::visit(ExpressionStatementAST *ast)
     return false;
 }
 
-void RangeAnalysis::mapUnion(VersionedMap<const CPlusPlus::Symbol*, Range> *a,
-                   VersionedMap<const CPlusPlus::Symbol*, Range> *b) {
-    std::set<const CPlusPlus::Symbol*> keys;
-    for (auto it = a->begin(); it != a->end(); ++it) {
-        keys.insert(it->first);
-    }
-    for (auto it = b->begin(); it != b->end(); ++it) {
-        keys.insert(it->first);
-    }
-
-    for (auto it : keys) {
-        const auto ifV = a->find(it);
-        const auto elseV = b->find(it);
-
-        if (ifV == a->end()) {
-            PSYCHE_ASSERT(elseV != b->end(), return , "expected that the map contains the key value - a");
-            Range range(elseV->second);
-            insertOrAssign(it, std::move(range));
-            continue;
+void RangeAnalysis::mapUnion(const RangeMap::Snapshot& a,
+                             const RangeMap::Snapshot& b)
+{
+    // Both branches derive from the current map, so the bindings they still
+    // share are already here: only the differing ones must be joined.
+    RangeMap::Snapshot::diff(a, b, [this](const CPlusPlus::Symbol* symbol,
+                                          const Range* ifV,
+                                          const Range* elseV) {
+        if (!ifV) {
+            insertOrAssign(symbol, Range(*elseV));
+            return;
         }
-        if (elseV == b->end()) {
-            PSYCHE_ASSERT(ifV != a->end(), return , "expected that the map contains the key value - b");
-            Range range(ifV->second);
-            insertOrAssign(it, std::move(range));
-            continue;
+        if (!elseV) {
+            insertOrAssign(symbol, Range(*ifV));
+            return;
         }
-        Range rangeIf(ifV->second);
-        Range rangeElse(elseV->second);
         Range range(std::make_unique<NAryValue>(
-                        rangeIf.lower_->clone(),
-                        rangeElse.lower_->clone(),
+                        ifV->lower_->clone(),
+                        elseV->lower_->clone(),
                         Operation::Minimum),
                     std::make_unique<NAryValue>(
-                        rangeIf.upper_->clone(),
-                        rangeElse.upper_->clone(),
+                        ifV->upper_->clone(),
+                        elseV->upper_->clone(),
                         Operation::Maximum));
-       insertOrAssign(it, range.evaluate());
-    }
+        insertOrAssign(symbol, range.evaluate());
+    });
 }
 
 std::unique_ptr<Range> RangeAnalysis::getRangeOfSymbol(const CPlusPlus::Symbol* symbol) {
@@ -1096,7 +1173,7 @@ bool RangeAnalysis::visit(IfStatementAST *ast)
 
             accept(ast->statement);
 
-            VersionedMap<const CPlusPlus::Symbol*, Range> ifTrueRangeMap(rangeMap_);
+            RangeMap::Snapshot ifTrueRangeMap(rangeMap_.snapshot());
 
             rangeMap_.applyRevision(revision);
 
@@ -1109,11 +1186,11 @@ bool RangeAnalysis::visit(IfStatementAST *ast)
             if (ast->else_statement)
                 accept(ast->else_statement);
 
-            VersionedMap<const CPlusPlus::Symbol*, Range> ifFalseRangeMap(rangeMap_);
+            RangeMap::Snapshot ifFalseRangeMap(rangeMap_.snapshot());
 
             rangeMap_.applyRevision(revision);
 
-            mapUnion(&ifTrueRangeMap, &ifFalseRangeMap);
+            mapUnion(ifTrueRangeMap, ifFalseRangeMap);
 
             return false;
         }
@@ -1125,91 +1202,175 @@ bool RangeAnalysis::visit(IfStatementAST *ast)
     if (ast->statement) {
         accept(ast->statement);
     }
-    VersionedMap<const CPlusPlus::Symbol*, Range> ifRangeMap(rangeMap_);
+    RangeMap::Snapshot ifRangeMap(rangeMap_.snapshot());
     rangeMap_.applyRevision(revision);
     if (ast->else_statement) {
         accept(ast->else_statement);
     }
-    VersionedMap<const CPlusPlus::Symbol*, Range> elseRangeMap(rangeMap_);
+    RangeMap::Snapshot elseRangeMap(rangeMap_.snapshot());
     rangeMap_.applyRevision(revision);
 
-    mapUnion(&ifRangeMap, &elseRangeMap);
+    mapUnion(ifRangeMap, elseRangeMap);
 
     return false;
 }
 
-void RangeAnalysis::wideRanges(std::map<const CPlusPlus::Symbol*, Range> &refValues,
-                               std::map<const CPlusPlus::Symbol*, std::list<Range> > &history)
+// Whether the bound a is known to be lower than or equal to the bound b.
+bool boundIsLowerOrEqual(const AbstractValue& a, const AbstractValue& b)
 {
-    for (auto const& itHist : history) {
-        bool ld = lowerIsDecreasing(itHist.second);
-        bool ug = upperIsGrowing(itHist.second);
-        if (ld && ug) {
-            // [-Inf, +Inf]
-            Range newRange(std::make_unique<InfinityValue>(Negative), std::make_unique<InfinityValue>(Positive));
+    if (&a == &b || a == b)
+        return true;
+    if (a.getKindOfValue() == KInfinity
+            && static_cast<const InfinityValue&>(a).getSign() == Negative) {
+        return true;
+    }
+    if (b.getKindOfValue() == KInfinity
+            && static_cast<const InfinityValue&>(b).getSign() == Positive) {
+        return true;
+    }
 
-            const auto itRef = refValues.find(itHist.first);
-            if (itRef != refValues.end()) {
-                // make the union of current value with the old value
-                Range rangeUnion(itRef->second.rangeUnion(newRange));
+    LinearValue la, lb;
+    if (!LinearValue::fromValue(a, la) || !LinearValue::fromValue(b, lb)
+            || !lb.add(la, -1)) {
+        return false;
+    }
+    return lb.isConstant() && lb.constant() >= 0;
+}
 
-                if (rangeUnion != itRef->second) {
-                    refValues.insert(std::make_pair(itHist.first, rangeUnion));
-                    insertOrAssign(itHist.first, std::move(rangeUnion));
-                }
-            } else {
-                refValues.insert(std::make_pair(itHist.first, newRange));
-                insertOrAssign(itHist.first, std::move(newRange));
-            }
-        } else if (ld) {
-            // [-Inf, u]
-            Range newRange(std::make_unique<InfinityValue>(Negative), itHist.second.back().upper_->clone());
-
-            const auto itRef = refValues.find(itHist.first);
-            if (itRef != refValues.end()) {
-                // make the union of current value with the old value
-                Range rangeUnion(itRef->second.rangeUnion(newRange));
-
-                if (rangeUnion != itRef->second) {
-                    refValues.insert(std::make_pair(itHist.first, rangeUnion));
-                    insertOrAssign(itHist.first, std::move(rangeUnion));
-                }
-            } else {
-                refValues.insert(std::make_pair(itHist.first, newRange));
-                insertOrAssign(itHist.first, std::move(newRange));
-            }
-        } else if (ug) {
-            // [l, +Inf]
-            Range newRange(itHist.second.back().lower_->clone(), std::make_unique<InfinityValue>(Positive));
-
-            const auto itRef = refValues.find(itHist.first);
-            if (itRef != refValues.end()) {
-                // make the union of current value with the old value
-                Range rangeUnion(itRef->second.rangeUnion(newRange));
-
-                if (rangeUnion != itRef->second) {
-                    refValues.insert(std::make_pair(itHist.first, rangeUnion));
-                    insertOrAssign(itHist.first, std::move(rangeUnion));
-                }
-            } else {
-                refValues.insert(std::make_pair(itHist.first, newRange));
-                insertOrAssign(itHist.first, std::move(newRange));
+bool rangeContains(const Range& outer, const Range& inner)
+{
+    return boundIsLowerOrEqual(*outer.lower_, *inner.lower_)
+            && boundIsLowerOrEqual(*inner.upper_, *outer.upper_);
+}
+
+bool isInfinity(const AbstractValue& value)
+{
+    return value.getKindOfValue() == KInfinity;
+}
+
+bool isAffine(const AbstractValue& value)
+{
+    LinearValue linear;
+    return LinearValue::fromValue(value, linear);
+}
+
+// The closest threshold beyond both values (above them if upper), or infinity.
+std::unique_ptr<AbstractValue> thresholdBeyond(const AbstractValue& a, const AbstractValue& b,
+                                               const std::vector<LinearValue>& thresholds,
+                                               bool upper)
+{
+    LinearValue la, lb;
+    if (LinearValue::fromValue(a, la) && LinearValue::fromValue(b, lb)) {
+        const LinearValue* best = nullptr;
+        int64_t bestGap = 0;
+        for (const auto& threshold : thresholds) {
+            LinearValue da(threshold), db(threshold);
+            if (!da.add(la, -1) || !db.add(lb, -1)
+                    || !da.isConstant() || !db.isConstant()) {
+                continue;
             }
+            const int64_t gapA = upper ? da.constant() : -da.constant();
+            const int64_t gapB = upper ? db.constant() : -db.constant();
+            if (gapA < 0 || gapB < 0 || (best && gapB >= bestGap))
+                continue;
+            best = &threshold;
+            bestGap = gapB;
         }
+        if (best)
+            return best->toValue()->evaluate();
     }
+
+    return std::make_unique<InfinityValue>(upper ? Positive : Negative);
 }
 
-void printHistory(std::map<const CPlusPlus::Symbol*, std::list<Range> > const history)
+Range RangeAnalysis::widenRange(const Range& head, const Range& now,
+                                const std::vector<LinearValue>& thresholds)
 {
-    std::cout << " history - begin ///////////////////////////////////////// " << std::endl;
-    for (auto &a : history) {
-        std::cout << a.first->name()->asNameId()->identifier()->chars() << ": ";
-        for (auto &b : a.second) {
-            std::cout << b << " ";
+    bool lowerIsDecreasing = *head.lower_ > (*now.lower_.get());
+    bool upperIsGrowing = *head.upper_ < (*now.upper_.get());
+    bool upperIsTheSame = head.upper_ == now.upper_ || *head.upper_ == (*now.upper_.get());
+    bool lowerIsTheSame = head.lower_ == now.lower_ || *head.lower_ == (*now.lower_.get());
+
+    if (lowerIsDecreasing && upperIsGrowing) {
+        // [next threshold below, next threshold above] (infinity past them)
+        return Range(thresholdBeyond(*head.lower_, *now.lower_, thresholds, false),
+                     thresholdBeyond(*head.upper_, *now.upper_, thresholds, true));
+    } else if (lowerIsDecreasing) {
+        // [next threshold below, u]
+        Range newRange(thresholdBeyond(*head.lower_, *now.lower_, thresholds, false),
+                       now.upper_->clone());
+        return Range(head).rangeUnion(newRange);
+    } else if (upperIsGrowing) {
+        // [l, next threshold above]
+        Range newRange(now.lower_->clone(),
+                       thresholdBeyond(*head.upper_, *now.upper_, thresholds, true));
+        return Range(head).rangeUnion(newRange);
+    }
+
+    // can't handle the values
+    std::unique_ptr<AbstractValue> lower;
+    if (lowerIsTheSame) lower = head.lower_->clone();
+    else lower = thresholdBeyond(*head.lower_, *now.lower_, thresholds, false);
+
+    std::unique_ptr<AbstractValue> upper;
+    if (upperIsTheSame) upper = head.upper_->clone();
+    else upper = thresholdBeyond(*head.upper_, *now.upper_, thresholds, true);
+
+    return Range(std::move(lower), std::move(upper));
+}
+
+std::vector<LinearValue> RangeAnalysis::loopThresholds(StatementAST *ast)
+{
+    std::vector<LinearValue> thresholds;
+    for (auto constant : functionConstants_)
+        thresholds.push_back(LinearValue(constant));
+
+    ExpressionAST* condition = nullptr;
+    if (ast->asWhileStatement())
+        condition = ast->asWhileStatement()->condition;
+    else if (ast->asForStatement())
+        condition = ast->asForStatement()->condition;
+    if (!condition || !condition->asBinaryExpression()
+            || !isRelational(tokenKind(condition->asBinaryExpression()->binary_op_token))) {
+        return thresholds;
+    }
+
+    // The bounds of both operands, one less and one more (e.g., for i < n,
+    // the body sees i up to n - 1 and leaves it up to n).
+    ExpressionAST* operands[] = { condition->asBinaryExpression()->left_expression,
+                                  condition->asBinaryExpression()->right_expression };
+    for (auto operand : operands) {
+        std::unique_ptr<Range> range;
+        if (operand->asIdExpression()) {
+            range = getRangeOfSymbol(lookupValueSymbol(operand->asIdExpression()->name->name, scope_));
+        } else {
+            accept(operand);
+            range = std::make_unique<Range>(stack_.top());
+            stack_.pop();
+        }
+        if (!range)
+            continue;
+        for (auto bound : { range->lower_, range->upper_ }) {
+            LinearValue linear;
+            if (!LinearValue::fromValue(*bound, linear))
+                continue;
+            for (int64_t delta : { -1, 0, 1 }) {
+                LinearValue threshold(linear);
+                if (threshold.add(LinearValue(delta)))
+                    thresholds.push_back(threshold);
+            }
         }
-        std::cout << std::endl;
     }
-    std::cout << " history - end   ///////////////////////////////////////// " << std::endl;
+
+    return thresholds;
+}
+
+void RangeAnalysis::setLoopState(uint32_t revision,
+                                 const std::map<const CPlusPlus::Symbol*, Range>& state)
+{
+    rangeMap_.applyRevision(revision);
+    for (auto const& it : state)
+        insertOrAssign(it.first, it.second);
 }
 
 void RangeAnalysis::visitLoopBody(StatementAST *ast)
@@ -1248,94 +1409,100 @@ void RangeAnalysis::visitLoopConditionWhenFalse(StatementAST *ast)
 
 bool RangeAnalysis::visitLoop(StatementAST *ast)
 {
-    if (!savingStateEnable_)
-        return false;
+    // A loop may be nested in one whose body is being probed: it is solved
+    // all the same, since its effects are part of that body, but the state of
+    // its statements is only saved by the visit that saves the outer ones.
+    const bool saving = savingStateEnable_;
 
     if (ast->asForStatement())
         accept(ast->asForStatement()->initializer);
 
     const auto revision = rangeMap_.revision();
 
-    std::map<const CPlusPlus::Symbol*, Range> refValues; // reference values used to see if some value was changed
-    std::map<const CPlusPlus::Symbol*, std::list<Range> > history; // map with the list of modifications of the ranges of each symbol
+    std::map<const CPlusPlus::Symbol*, Range> refValues; // ranges before the loop
     std::list<const CPlusPlus::Symbol*> symbolsBeforeLoop; // symbols with a range before the loop
 
     for (auto const& it : rangeMap_) {
         refValues.insert(std::make_pair(it.first, it.second));
-        history[it.first].push_back(it.second);
         symbolsBeforeLoop.push_back(it.first);
     }
 
+    LoopStats& stats = loopStats_[ast];
+    ++stats.visits_;
+    // The thresholds visit the operands of the condition, which the visit
+    // that saves the state does again.
     savingStateEnable_ = false;
-    visitLoopBody(ast);
-    savingStateEnable_ = true;
-
-    for (auto const& it : rangeMap_) {
-        history[it.first].push_back(it.second);
-    }
-
-    for (auto &it : refValues) {
-        bool lowerIsDecreasing = *it.second.lower_ > (*history[it.first].back().lower_.get());
-        bool upperIsGrowing = *it.second.upper_ < (*history[it.first].back().upper_.get());
-        bool upperIsTheSame = *it.second.upper_ == (*history[it.first].back().upper_.get());
-        bool lowerIsTheSame = *it.second.lower_ == (*history[it.first].back().lower_.get());
-
-        if (lowerIsDecreasing && upperIsGrowing) {
-            // [-Inf, +Inf]
-            Range newRange(std::make_unique<InfinityValue>(Negative),
-                           std::make_unique<InfinityValue>(Positive));
-            insertOrAssign(it.first, std::move(newRange));
-        } else if (lowerIsDecreasing) {
-            // [-Inf, u]
-            Range newRange(std::make_unique<InfinityValue>(Negative),
-                           history[it.first].back().upper_->clone());
-            Range rangeUnion(it.second.rangeUnion(newRange));
-            insertOrAssign(it.first, std::move(rangeUnion));
-        } else if (upperIsGrowing) {
-            // [l, +Inf]
-            Range newRange(history[it.first].back().lower_->clone(),
-                    std::make_unique<InfinityValue>(Positive));
-            Range rangeUnion(it.second.rangeUnion(newRange));
-            insertOrAssign(it.first, std::move(rangeUnion));
-        } else { // can't handle the values
-            std::unique_ptr<AbstractValue> lower;
-            if(lowerIsTheSame) lower = it.second.lower_->clone();
-            else lower = std::make_unique<InfinityValue>(Negative);
-
-            std::unique_ptr<AbstractValue> upper;
-            if(upperIsTheSame) upper = it.second.upper_->clone();
-            else upper = std::make_unique<InfinityValue>(Positive);
-
-            Range newRange(std::move(lower),
-                           std::move(upper));
-            insertOrAssign(it.first, std::move(newRange));
+    const std::vector<LinearValue> thresholds = loopThresholds(ast);
+
+    // Ranges at the head of the loop. Starting from the ranges before the
+    // loop, visit the body and widen the ranges that it changes, until the
+    // body changes none (the worklist is empty). Past maxLoopIterations_,
+    // the thresholds are dropped and the bounds that move go to infinity.
+    std::map<const CPlusPlus::Symbol*, Range> head(refValues);
+    std::list<const CPlusPlus::Symbol*> worklist(symbolsBeforeLoop);
+    const std::vector<LinearValue> noThresholds;
+
+    for (unsigned i = 0; !worklist.empty() && i < 2 * maxLoopIterations_; ++i) {
+        ++stats.iterations_;
+        setLoopState(revision, head);
+        visitLoopBody(ast);
+
+        worklist.clear();
+        for (auto &it : head) {
+            const auto now = rangeMap_.find(it.first);
+            if (now == rangeMap_.end() || rangeContains(it.second, now->second))
+                continue;
+            it.second = widenRange(it.second, now->second,
+                                   i < maxLoopIterations_ ? thresholds : noThresholds);
+            worklist.push_back(it.first);
         }
     }
-    /*if (ast->asForStatement())
-        LoopAnalyser loopAnalyser(unit_, ast, history, scope_);
-    else if (ast->asWhileStatement())
-        LoopAnalyser loopAnalyser(unit_, ast, history, scope_);
-    else if (ast->asDoStatement()) {
-        cout << "ERROR: bool RangeAnalysis::visitLoop(StatementAST *ast):"
-                " do while loop not implemented yet!" << endl;
-        exit(1);
-    } else {
-        cout << "ERROR: bool RangeAnalysis::visitLoop(StatementAST *ast):"
-                " unexpected loop!" << endl;
-        exit(1);
-    }//*/
-
-    /*// Reinitialization of the variants' ranges to [v, v]
-    for (auto const& it : rangeMap_) {
-        bool upperIsTheSame = *it.second.upper_ == (*history[it.first].back().upper_.get());
-        bool lowerIsTheSame = *it.second.lower_ == (*history[it.first].back().lower_.get());
-        if (!upperIsTheSame || !lowerIsTheSame) {
-            std::unique_ptr<AbstractValue> symb = SymbolValue(it.first).evaluate();
-            Range newRange(symb->clone(), symb->clone());
-            insertOrAssign(it.first, std::move(newRange));
+    // Give up on what still changes.
+    for (auto sym : worklist) {
+        head.at(sym) = Range(std::make_unique<InfinityValue>(Negative),
+                             std::make_unique<InfinityValue>(Positive));
+    }
+
+    // Narrowing: widening may have gone farther than needed, visit the body
+    // again (now under the loop condition) and take back the infinite bounds
+    // for which the ranges before the loop joined with the ones after the
+    // body give an affine value.
+    for (unsigned i = 0; i < narrowingPasses_; ++i) {
+        if (std::none_of(head.begin(), head.end(), [](const auto& it) {
+                return isInfinity(*it.second.lower_) || isInfinity(*it.second.upper_);
+            })) {
+            break;
         }
-    }*/
+        setLoopState(revision, head);
+        visitLoopConditionWhenTrue(ast);
+        visitLoopBody(ast);
+
+        bool narrowed = false;
+        for (auto &it : head) {
+            const auto now = rangeMap_.find(it.first);
+            if (now == rangeMap_.end())
+                continue;
+            Range entry(refValues.at(it.first).rangeUnion(now->second));
+            std::shared_ptr<const AbstractValue> lower = it.second.lower_;
+            std::shared_ptr<const AbstractValue> upper = it.second.upper_;
+            if (isInfinity(*lower) && isAffine(*entry.lower_)) {
+                lower = entry.lower_;
+                ++stats.narrowedBounds_;
+                narrowed = true;
+            }
+            if (isInfinity(*upper) && isAffine(*entry.upper_)) {
+                upper = entry.upper_;
+                ++stats.narrowedBounds_;
+                narrowed = true;
+            }
+            it.second = Range(lower->clone(), upper->clone());
+        }
+        if (!narrowed)
+            break;
+    }
+    savingStateEnable_ = saving;
 
+    setLoopState(revision, head);
     visitLoopConditionWhenTrue(ast);
     visitLoopBody(ast);
 
@@ -1423,44 +1590,6 @@ bool RangeAnalysis::visit(ForStatementAST *ast)
 // ----------------------------------------------------------------
 // ----------------------------------------------------------------
 
-bool RangeAnalysis::lowerIsDecreasing(const std::list<Range> &ranges)
-{
-    if (ranges.size() <= 2)
-        return false;
-
-    auto it1 = ranges.begin();
-    auto it2 = std::next(ranges.begin());
-
-    while(it2 != ranges.end() && it1 != it2) {
-        if (*it1->lower_ < (*it2->lower_.get())) {
-            return false;
-        }
-        std::swap(it1, it2);
-        it2 = std::next(it2);
-    }
-
-    return true;
-}
-
-bool RangeAnalysis::upperIsGrowing(const std::list<Range> &ranges)
-{
-    if (ranges.size() <= 2)
-        return false;
-
-    auto it1 = ranges.begin();
-    auto it2 = std::next(ranges.begin());
-
-    while(it2 != ranges.end() && it1 != it2) {
-        if (*it1->upper_ > (*it2->lower_.get())) {
-            return false;
-        }
-        std::swap(it1, it2);
-        it2 = std::next(it2);
-    }
-
-    return true;
-}
-
 Range RangeAnalysis::rangeForAWhenTrue(Range *rangeA, Range *rangeB,
                                                        unsigned op)
 {
@@ -21,10 +21,12 @@
 #define PSYCHE_RANGEANALYSIS_H__
 
 #include "ASTVisitor.h"
+#include "LinearValue.h"
 #include "Range.h"
 #include "VersionedMap.h"
 #include <stack>
 #include <map>
+#include <vector>
 
 namespace psyche {
 
@@ -44,9 +46,33 @@ struct ArrayInfo {
 class RangeAnalysis final : public CPlusPlus::ASTVisitor
 {
 public:
+    using RangeMap = VersionedMap<const CPlusPlus::Symbol*, Range>;
+
     RangeAnalysis(CPlusPlus::TranslationUnit *unit);
 
-    void run(CPlusPlus::TranslationUnitAST *ast, CPlusPlus::Namespace *global);
+    /*!
+     * \brief run
+     * \param ast
+     * \param global
+     * \param function
+     *
+     * Analyse the translation unit or, if \a function is given, only that
+     * function and the declarations that precede it.
+     */
+    void run(CPlusPlus::TranslationUnitAST *ast, CPlusPlus::Namespace *global,
+             CPlusPlus::FunctionDefinitionAST *function = nullptr);
+
+    /*!
+     * \brief setLoopOptions
+     * \param maxIterations
+     * \param narrowingPasses
+     *
+     * A loop's body is visited up to \a maxIterations times to find its
+     * invariant by widening to thresholds, then the bounds that still move go
+     * to infinity. \a narrowingPasses more visits refine the bounds that
+     * widening sent to infinity.
+     */
+    void setLoopOptions(unsigned int maxIterations, unsigned int narrowingPasses);
 
 //private:
     /*!
@@ -79,11 +105,33 @@ public:
      *
      * given two range maps this method merge then.
      */
-    void mapUnion(VersionedMap<const CPlusPlus::Symbol*, Range> *a,
-                       VersionedMap<const CPlusPlus::Symbol*, Range> *b);
+    void mapUnion(const RangeMap::Snapshot& a, const RangeMap::Snapshot& b);
+
+    /*!
+     * \brief widenRange
+     * \param head range of a symbol at the head of the loop
+     * \param now range of the symbol after the loop body
+     * \param thresholds
+     *
+     * A range that holds both \a head and \a now. A bound that moves goes to
+     * the closest threshold beyond it, or to infinity if there's none.
+     */
+    Range widenRange(const Range& head, const Range& now,
+                     const std::vector<LinearValue>& thresholds);
+
+    /*!
+     * \brief loopThresholds
+     * \param ast
+     *
+     * Widening thresholds of a loop: the bounds of the operands of its
+     * condition (and their neighbours), and the constants of the function.
+     */
+    std::vector<LinearValue> loopThresholds(CPlusPlus::StatementAST *ast);
+
+    //! Restore the given revision and overwrite it with the given ranges.
+    void setLoopState(uint32_t revision,
+                      const std::map<const CPlusPlus::Symbol*, Range>& state);
 
-    void wideRanges(std::map<const CPlusPlus::Symbol*, Range> &refValues,
-                    std::map<const CPlusPlus::Symbol*, std::list<Range> > &history);
     /*!
      * \brief returns the range of a given symbol
      * \param symbol
@@ -96,9 +144,22 @@ public:
      * \brief save all table of ranges in a given point of the program
      * \param statement
      *
+     * The table is a snapshot of the range map: it shares all the ranges that
+     * didn't change since the previous statement, so a point costs as much as
+     * the definitions that reach it for the first time.
      */
     void saveState(const CPlusPlus::StatementAST* stmt);
 
+    /*!
+     * \brief rangeAt
+     * \param stmt
+     * \param symbol
+     *
+     * The range of \a symbol after \a stmt, or null if there's none.
+     */
+    const Range* rangeAt(const CPlusPlus::StatementAST* stmt,
+                         const CPlusPlus::Symbol* symbol) const;
+
     // auxiliary functions to extract information from boolean expressions that are
     // composed by two symbols
     // example: "if (va < vb) then St else Sf"
@@ -115,9 +176,6 @@ public:
     Range rangeForAWhenFalse(Range *lrange, Range *rrange,unsigned op); // va : [max(la, lb), ua]
     Range rangeForBWhenFalse(Range *lrange, Range *rrange,unsigned op); // vb : [lb, min(ua, ub)]
 
-    bool lowerIsDecreasing(const std::list<Range> &ranges);
-    bool upperIsGrowing(const std::list<Range> &ranges);
-
     // Top-level visitation entry points.
     void visitStatement(CPlusPlus::StatementAST *ast);
     void visitDeclaration(CPlusPlus::DeclarationAST *ast);
@@ -174,6 +232,7 @@ public:
                                CPlusPlus::ExpressionAST*,
                                const CPlusPlus::StatementAST*);
     void printResult();
+    void printLoopStats();
     void dumpPointerIsArray();
 
     //! Scope we're in.
@@ -189,10 +248,29 @@ public:
     CPlusPlus::StatementAST* enclosingStmt_;
 
     std::unordered_map<const CPlusPlus::StatementAST*, int32_t> revisionMap_;
-    VersionedMap<const CPlusPlus::Symbol*, Range> rangeMap_;
+    RangeMap rangeMap_;
 
     // deal with loops
     bool savingStateEnable_;
+
+    /*!
+     * \brief The LoopStats struct
+     *
+     * How many times a loop was analysed (an inner loop is analysed once per
+     * visit of the outer body), how many times its body was visited to find
+     * its invariant, and how many infinite bounds narrowing brought back.
+     */
+    struct LoopStats
+    {
+        unsigned int visits_ { 0 };
+        unsigned int iterations_ { 0 };
+        unsigned int narrowedBounds_ { 0 };
+    };
+    std::map<const CPlusPlus::StatementAST*, LoopStats> loopStats_;
+    unsigned int maxLoopIterations_;
+    unsigned int narrowingPasses_;
+    //! Integer constants of the function being analysed.
+    std::vector<int64_t> functionConstants_;
     void enteringInsideTheLoop(const CPlusPlus::StatementAST*);
     void goingOutFromTheLoop();
 
@@ -213,8 +291,7 @@ public:
     CPlusPlus::TranslationUnit* unit_;
 
     // range analysis values/programPoint
-    std::map<const CPlusPlus::StatementAST*,
-             std::list<std::pair<const CPlusPlus::Symbol*, Range> > > rangeAnalysis_;
+    std::map<const CPlusPlus::StatementAST*, RangeMap::Snapshot> rangeAnalysis_;
     std::list<const CPlusPlus::StatementAST*> statementsOrder_;
 
     // boolean used to initialize just parameters values (function parameters
@@ -19,6 +19,7 @@
 
 #include "Runner.h"
 #include "AST.h"
+#include "Artifacts.h"
 #include "AstFixer.h"
 #include "Bind.h"
 #include "Control.h"
@@ -33,8 +34,15 @@
 #include "Symbols.h"
 #include "TranslationUnit.h"
 #include "Utils.h"
+#include "ValueTable.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
 #include <sstream>
+#include <streambuf>
+#include <thread>
+#include <vector>
 #include "FunctionGenerator.h"
 
 using namespace CPlusPlus;
@@ -44,6 +52,150 @@ namespace psyche {
 extern bool debugEnabled;
 bool displayStats;
 
+namespace {
+
+/*!
+ * \brief The FunctionLogBuffer class
+ *
+ * Buffer of std::cout while functions are analysed concurrently: what a
+ * thread prints goes to the log of the function it's working on, and the
+ * logs are printed in the order of the functions once all of them are done.
+ */
+class FunctionLogBuffer final : public std::streambuf
+{
+public:
+    explicit FunctionLogBuffer(std::streambuf* out) : out_(out) {}
+
+    //! The log the current thread prints to (std::cout itself if null).
+    static thread_local std::string* log_;
+
+protected:
+    int overflow(int c) override
+    {
+        if (c == traits_type::eof())
+            return traits_type::not_eof(c);
+        if (log_) {
+            log_->push_back(traits_type::to_char_type(c));
+            return c;
+        }
+        return out_->sputc(traits_type::to_char_type(c));
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        if (log_) {
+            log_->append(s, n);
+            return n;
+        }
+        return out_->sputn(s, n);
+    }
+
+    int sync() override
+    {
+        return log_ ? 0 : out_->pubsync();
+    }
+
+private:
+    std::streambuf* out_;
+};
+
+thread_local std::string* FunctionLogBuffer::log_ = nullptr;
+
+/*!
+ * \brief analyseFunction
+ *
+ * Run the range analysis and generate the main of a single function. All the
+ * state lives in here, so functions can be analysed on different threads.
+ */
+void analyseFunction(TranslationUnit* program, TranslationUnitAST* ast,
+                     Namespace* globalNs, FunctionDefinitionAST* function,
+                     std::vector<std::string>& mains)
+{
+    RangeAnalysis rangeAnalysis(program);
+    rangeAnalysis.setLoopOptions(loopIterations, narrowingPasses);
+    rangeAnalysis.run(ast, globalNs, function);
+    //std::cout << "Range Analysis... ok!" << std::endl;
+    if (displayStats) {
+        std::cout << "Loop fixpoint stats" << std::endl;
+        rangeAnalysis.printLoopStats();
+    }
+    DependentTypesGenerator dependentTypesGenerator(rangeAnalysis);
+    dependentTypesGenerator.generate();
+    //std::cout << "Dependent Types Generator... ok!" << std::endl;
+    FunctionGenerator functionGenerator(program, dependentTypesGenerator);
+    functionGenerator.generate(ast, globalNs, function);
+    //std::cout << "Function Generator... ok!" << std::endl;
+    mains = functionGenerator.mainFiles();
+    if (displayStats) {
+        std::cout << "Normal forms stats" << std::endl
+                  << ValueTable::instance().stats() << std::endl;
+    }
+}
+
+/*!
+ * \brief analyseFunctions
+ *
+ * Analyse the functions of the translation unit over \a jobs threads. The
+ * output is the same as if they were analysed one after the other.
+ */
+void analyseFunctions(TranslationUnit* program, TranslationUnitAST* ast,
+                      Namespace* globalNs, unsigned int jobs,
+                      std::vector<std::string>& mains)
+{
+    std::vector<FunctionDefinitionAST*> functions;
+    for (DeclarationListAST *it = ast->declaration_list; it; it = it->next) {
+        if (FunctionDefinitionAST* function = it->value->asFunctionDefinition())
+            functions.push_back(function);
+    }
+
+    if (!jobs)
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min<std::size_t>(jobs, functions.size());
+
+    std::vector<std::vector<std::string> > functionMains(functions.size());
+    if (jobs <= 1) {
+        for (std::size_t i = 0; i < functions.size(); ++i) {
+            analyseFunction(program, ast, globalNs, functions[i], functionMains[i]);
+            mains.insert(mains.end(), functionMains[i].begin(), functionMains[i].end());
+        }
+        return;
+    }
+
+    std::vector<std::string> logs(functions.size());
+    std::vector<std::exception_ptr> errors(functions.size());
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < functions.size(); i = next++) {
+            FunctionLogBuffer::log_ = &logs[i];
+            try {
+                analyseFunction(program, ast, globalNs, functions[i], functionMains[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+            FunctionLogBuffer::log_ = nullptr;
+        }
+    };
+
+    FunctionLogBuffer buffer(std::cout.rdbuf());
+    std::streambuf* previous = std::cout.rdbuf(&buffer);
+    std::vector<std::thread> pool;
+    for (unsigned int i = 1; i < jobs; ++i)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool)
+        thread.join();
+    std::cout.rdbuf(previous);
+
+    for (std::size_t i = 0; i < functions.size(); ++i) {
+        std::cout << logs[i] << std::flush;
+        if (errors[i])
+            std::rethrow_exception(errors[i]);
+        mains.insert(mains.end(), functionMains[i].begin(), functionMains[i].end());
+    }
+}
+
+} // anonymous
+
 /*!
  * \brief analyseProgram
  * \param source
@@ -95,7 +247,8 @@ std::unique_ptr<TranslationUnit> analyseProgram(const std::string& source,
     }
 
     TranslationUnitAST* ast = program->ast()->asTranslationUnit();
-    Dumper(program.get()).dump(ast, ".ast.dot");
+    if (Artifacts::wanted())
+        Dumper(program.get()).dump(ast, ".ast.dot");
 
     // Binding phase, this is when we create symbols.
     Namespace* globalNs = control.newNamespace(0, nullptr);
@@ -121,16 +274,10 @@ std::unique_ptr<TranslationUnit> analyseProgram(const std::string& source,
         options.constraints_.assign(oss.str());
     ////////////////////////////////////////
     //debugVisit = true;
+    debugVisit = false;
     debugEnabled = false;
-    RangeAnalysis rangeAnalysis(program.get());
-    rangeAnalysis.run(ast->asTranslationUnit(), globalNs);
-    //std::cout << "Range Analysis... ok!" << std::endl;
-    DependentTypesGenerator dependentTypesGenerator(rangeAnalysis);
-    dependentTypesGenerator.generate();
-    //std::cout << "Dependent Types Generator... ok!" << std::endl;
-    FunctionGenerator functionGenerator(program.get(), dependentTypesGenerator);
-    functionGenerator.generate(ast->asTranslationUnit(), globalNs);
-    //std::cout << "Function Generator... ok!" << std::endl;
+    options.mains_.clear();
+    analyseFunctions(program.get(), ast, globalNs, options.jobs_, options.mains_);
     ////////////////////////////////////////
 
     return program;
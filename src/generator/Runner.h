@@ -23,12 +23,13 @@
 #include "CPlusPlusForwardDeclarations.h"
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace psyche {
 
 struct AnalysisOptions
 {
-    AnalysisOptions() : flags_(~0) {}
+    AnalysisOptions() : flags_(~0), jobs_(0) {}
 
     struct Flags
     {
@@ -46,6 +47,12 @@ struct AnalysisOptions
     };
 
     std::string constraints_;
+
+    //! How many functions are analysed at once (0 for one per hardware thread).
+    unsigned int jobs_;
+
+    //! The main files written by the analysis, in the order of the functions.
+    std::vector<std::string> mains_;
 };
 
 std::unique_ptr<CPlusPlus::TranslationUnit>
@@ -28,15 +28,21 @@
 #include "Bind.h"
 #include "Control.h"
 #include "Debug.h"
+#include "DenseGraph.h"
 #include "DiagnosticCollector.h"
 #include "Dumper.h"
+#include "LinearValue.h"
 #include "Literals.h"
+#include "MinMaxSet.h"
 #include "RangeAnalysis.h"
 #include "TranslationUnit.h"
 #include "Utils.h"
+#include "ValueTable.h"
 #include <algorithm>
 #include <cctype>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string.h>
@@ -57,6 +63,29 @@ static IntegerValue two(2);
 static InfinityValue pinf(Sign::Positive);
 static InfinityValue minf(Sign::Negative);
 
+//! The edges of a frozen graph, as "vertex(label label...)" in their order.
+std::string edgesText(const DenseGraph<std::string>& graph,
+                      DenseGraph<std::string>::Slice<DenseGraph<std::string>::Edge> edges)
+{
+    std::string ret = "";
+    for (const auto& edge : edges) {
+        std::string labels = "";
+        for (int label : graph.labels(edge))
+            labels += (labels.empty() ? "" : " ") + std::to_string(label);
+        ret += graph.vertex(edge.vertex_) + "(" + labels + ") ";
+    }
+    return ret;
+}
+
+//! The vertices of a graph, in the order it visits them.
+std::string verticesText(const DenseGraph<std::string>& graph)
+{
+    std::string ret = "";
+    for (auto it = graph.begin(); it != graph.end(); ++it)
+        ret += *it + "=" + std::to_string(it.id()) + " ";
+    return ret;
+}
+
 } // anonymous
 
 /*
@@ -99,7 +128,9 @@ void Tester::checkConstraints(const std::string &source, std::string expected)
     compareText(expected, options_.constraints_);
 }
 
-std::string getRanges(const std::string& source) {
+//! Run the range analysis on \a source, and describe it with \a print.
+std::string analyseRanges(const std::string& source,
+                          const std::function<std::string(RangeAnalysis&)>& print) {
     StringLiteral name("asdas", strlen("asdas"));
     Control control;
     std::unique_ptr<CPlusPlus::TranslationUnit> program(new TranslationUnit(&control, &name));
@@ -144,16 +175,43 @@ std::string getRanges(const std::string& source) {
     RangeAnalysis rangeAnalysis(program.get());
     rangeAnalysis.run(ast->asTranslationUnit(), globalNs);
 
-    std::string ret = "";
-    auto itOrder = rangeAnalysis.statementsOrder_.back();
-    for (auto const& it : rangeAnalysis.rangeAnalysis_[itOrder]) {
-        std::string str = it.first->name()->asNameId()->identifier()->chars();
-        ret += str + " : "
-             + "[" + it.second.lower_->toString() + ", "
-             + it.second.upper_->toString() + "] ";
-    }
+    return print(rangeAnalysis);
+}
 
-    return ret;
+std::string getRanges(const std::string& source) {
+    return analyseRanges(source, [](RangeAnalysis& rangeAnalysis) {
+        std::string ret = "";
+        auto itOrder = rangeAnalysis.statementsOrder_.back();
+        for (auto const& it : rangeAnalysis.rangeAnalysis_[itOrder]) {
+            std::string str = it.first->name()->asNameId()->identifier()->chars();
+            ret += str + " : "
+                 + "[" + it.second.lower_->toString() + ", "
+                 + it.second.upper_->toString() + "] ";
+        }
+        return ret;
+    });
+}
+
+//! The number of accesses recorded for each dimension of the arrays, and
+//! the range of their indices.
+std::string getArrayAccesses(const std::string& source) {
+    return analyseRanges(source, [](RangeAnalysis& rangeAnalysis) {
+        std::string ret = "";
+        for (auto const& it : rangeAnalysis.arrayAccesses_) {
+            std::string str = it.first.first->name()->asNameId()->identifier()->chars();
+            ret += str + "[" + std::to_string(it.first.second) + "] : "
+                 + std::to_string(it.second.size()) + " ";
+        }
+        for (auto const& it : rangeAnalysis.arrayInfoMap_) {
+            std::string str = it.first->name()->asNameId()->identifier()->chars();
+            for (auto const& dim : it.second.dimensionRange_) {
+                ret += str + "[" + std::to_string(dim.first) + "] : "
+                     + "[" + dim.second.lower_->toString() + ", "
+                     + dim.second.upper_->toString() + "] ";
+            }
+        }
+        return ret;
+    });
 }
 
 void Tester::compareText(std::string expected, std::string actual) const
@@ -8108,3 +8166,495 @@ foo:[foo,foo]
 
     compareText(expected, output);
 }
+
+void Tester::testCaseRA31() // branches joined after another join
+{
+    std::string source = R"raw(
+ void foo() {
+   int a, b;
+   if (1) {
+     a = 1;
+   } else {
+     a = 2;
+   }
+   if (1) {
+     b = a + 10;
+     if (1) {
+       a = 5;
+     } else {
+       b = 3;
+     }
+   } else {
+     b = a;
+   }
+ }
+        )raw";
+
+    std::string expected = R"raw(
+b:[1,12]
+a:[1,5]
+foo:[foo,foo]
+    )raw";
+
+    std:string output = getRanges(source);
+
+    compareText(expected, output);
+}
+
+void Tester::testCaseRA32() // a counted loop stops at the threshold of its condition
+{
+    std::string source = R"raw(
+ void foo() {
+   int i = 0;
+   while (i < 1000) {
+     i = i + 3;
+   }
+ }
+        )raw";
+
+    std::string expected = R"raw(
+i:[0,1002]
+foo:[foo,foo]
+    )raw";
+
+    std:string output = getRanges(source);
+
+    compareText(expected, output);
+}
+
+void Tester::testCaseRA33() // a loop nested in another one
+{
+    std::string source = R"raw(
+ void foo() {
+   int i, j, k;
+   k = 0;
+   for (i = 0; i < 10; i++) {
+     for (j = 0; j < 20; j++) {
+       k = j;
+     }
+   }
+ }
+        )raw";
+
+    std::string expected = R"raw(
+k:[0,20]
+j:[0,20]
+i:[0,10]
+foo:[foo,foo]
+    )raw";
+
+    std:string output = getRanges(source);
+
+    compareText(expected, output);
+}
+
+void Tester::testCaseRA34() // a nested loop bounded by a condition of its body
+{
+    std::string source = R"raw(
+ void foo() {
+   int i, j, k;
+   k = 0;
+   for (i = 0; i < 10; i++) {
+     for (j = 0; j < 5; j++) {
+       if (k < 40)
+         k = k + 1;
+     }
+   }
+ }
+        )raw";
+
+    std::string expected = R"raw(
+k:[0,40]
+j:[0,5]
+i:[0,10]
+foo:[foo,foo]
+    )raw";
+
+    std:string output = getRanges(source);
+
+    compareText(expected, output);
+}
+
+void Tester::testCaseRA35() // the inner bound depends on the outer loop
+{
+    std::string source = R"raw(
+ void foo(int n) {
+   int i, j;
+   for (i = 0; i < n - 1; i++) {
+     for (j = 0; j < n - i - 1; j++) {
+     }
+   }
+ }
+        )raw";
+
+    std::string expected = R"raw(
+n:[n,n]
+i:[0,max((-1+n),0)]
+j:[0,max((-1+n),0)]
+foo:[foo,foo]
+    )raw";
+
+    std:string output = getRanges(source);
+
+    compareText(expected, output);
+}
+
+// Linear forms
+
+void Tester::testCaseLV1() // fromValue: 2*i + 3 + i
+{
+    SymbolValue i(i_);
+    unique_ptr<AbstractValue> v = *(*(two * i) + 3) + i;
+
+    LinearValue linear;
+    PSYCHE_EXPECT_TRUE(LinearValue::fromValue(*v, linear));
+    PSYCHE_EXPECT_INT_EQ(3, linear.constant());
+    PSYCHE_EXPECT_INT_EQ(3, linear.coefficient(i_));
+    PSYCHE_EXPECT_INT_EQ(0, linear.coefficient(j_));
+}
+
+void Tester::testCaseLV2() // fromValue: i*j, min(i, j) and i/2 aren't affine
+{
+    SymbolValue i(i_);
+    SymbolValue j(j_);
+    NAryValue product(i.clone(), j.clone(), Multiplication);
+    NAryValue min(i.clone(), j.clone(), Minimum);
+    NAryValue division(i.clone(), two.clone(), Division);
+
+    LinearValue linear;
+    PSYCHE_EXPECT_FALSE(LinearValue::fromValue(product, linear));
+    PSYCHE_EXPECT_FALSE(LinearValue::fromValue(min, linear));
+    PSYCHE_EXPECT_FALSE(LinearValue::fromValue(division, linear));
+}
+
+void Tester::testCaseLV3() // toValue: 5 + 2*i - j, and back
+{
+    LinearValue linear(5);
+    PSYCHE_EXPECT_TRUE(linear.add(LinearValue(i_, 2)));
+    PSYCHE_EXPECT_TRUE(linear.add(LinearValue(j_), -1));
+
+    std::string expected = "(5 + (2*i) + (-1*j))";
+    compareText(expected, linear.toString());
+
+    LinearValue back;
+    PSYCHE_EXPECT_TRUE(LinearValue::fromValue(*linear.toValue(), back));
+    PSYCHE_EXPECT_TRUE(back == linear);
+}
+
+void Tester::testCaseLV4() // add: (i + 2) - (i + 1) + (j + 0)
+{
+    LinearValue a(i_);
+    PSYCHE_EXPECT_TRUE(a.add(LinearValue(2)));
+    LinearValue b(i_);
+    PSYCHE_EXPECT_TRUE(b.add(LinearValue(1)));
+
+    PSYCHE_EXPECT_TRUE(a.add(b, -1));
+    PSYCHE_EXPECT_TRUE(a.isConstant());
+    PSYCHE_EXPECT_INT_EQ(1, a.constant());
+
+    PSYCHE_EXPECT_TRUE(a.add(LinearValue(j_)));
+    PSYCHE_EXPECT_FALSE(a.isConstant());
+    PSYCHE_EXPECT_INT_EQ(1, a.terms().size());
+    PSYCHE_EXPECT_INT_EQ(1, a.coefficient(j_));
+    PSYCHE_EXPECT_INT_EQ(0, a.coefficient(i_));
+}
+
+void Tester::testCaseLV5() // scale: 3*(i + 2), then 0*(3*i + 6)
+{
+    LinearValue linear(i_);
+    PSYCHE_EXPECT_TRUE(linear.add(LinearValue(2)));
+
+    PSYCHE_EXPECT_TRUE(linear.scale(3));
+    PSYCHE_EXPECT_INT_EQ(6, linear.constant());
+    PSYCHE_EXPECT_INT_EQ(3, linear.coefficient(i_));
+
+    PSYCHE_EXPECT_TRUE(linear.scale(0));
+    PSYCHE_EXPECT_TRUE(linear.isConstant());
+    PSYCHE_EXPECT_INT_EQ(0, linear.constant());
+}
+
+void Tester::testCaseLV6() // overflows of the constant and of a coefficient
+{
+    const int64_t max = std::numeric_limits<int64_t>::max();
+
+    LinearValue constant(max);
+    PSYCHE_EXPECT_FALSE(constant.add(LinearValue(1)));
+
+    LinearValue coefficient(i_, max);
+    PSYCHE_EXPECT_FALSE(coefficient.add(LinearValue(i_)));
+
+    LinearValue factor(i_);
+    PSYCHE_EXPECT_FALSE(factor.add(LinearValue(j_, 2), max));
+
+    LinearValue scaled(i_, max / 2 + 1);
+    PSYCHE_EXPECT_FALSE(scaled.scale(2));
+
+    // max * (2*i)
+    SymbolValue i(i_);
+    NAryValue product(std::make_unique<IntegerValue>(max),
+                      std::make_unique<NAryValue>(two.clone(), i.clone(), Multiplication),
+                      Multiplication);
+    LinearValue linear;
+    PSYCHE_EXPECT_FALSE(LinearValue::fromValue(product, linear));
+}
+
+// Operands of min and max
+
+void Tester::testCaseMM1() // a dominated operand is dropped: min(i + 1, i), min(i, i + 1)
+{
+    SymbolValue i(i_);
+
+    MinMaxSet removed(Minimum);
+    removed.insert(one + i);
+    removed.insert(i.clone());
+    PSYCHE_EXPECT_INT_EQ(1, removed.size());
+    compareText("i", removed.toValue()->toString());
+
+    MinMaxSet dropped(Minimum);
+    dropped.insert(i.clone());
+    dropped.insert(one + i);
+    PSYCHE_EXPECT_INT_EQ(1, dropped.size());
+    compareText("i", dropped.toValue()->toString());
+
+    MinMaxSet max(Maximum);
+    max.insert(i.clone());
+    max.insert(one + i);
+    max.insert(std::make_unique<InfinityValue>(Negative));
+    PSYCHE_EXPECT_INT_EQ(1, max.size());
+    compareText("(1 + i)", max.toValue()->toString());
+}
+
+void Tester::testCaseMM2() // incomparable operands are kept: min(i, j), min(i, 2*i)
+{
+    SymbolValue i(i_);
+    SymbolValue j(j_);
+
+    MinMaxSet symbols(Minimum);
+    symbols.insert(i.clone());
+    symbols.insert(j.clone());
+    PSYCHE_EXPECT_INT_EQ(2, symbols.size());
+
+    MinMaxSet scaled(Minimum);
+    scaled.insert(i.clone());
+    scaled.insert(two * i);
+    PSYCHE_EXPECT_INT_EQ(2, scaled.size());
+
+    // i*j isn't affine, it's only compared for equality
+    MinMaxSet product(Minimum);
+    product.insert(i.clone());
+    product.insert(i * j);
+    PSYCHE_EXPECT_INT_EQ(2, product.size());
+}
+
+void Tester::testCaseMM3() // equal operands are kept once: min(i, i), min(i*j, i*j), max(j, min(j, j))
+{
+    SymbolValue i(i_);
+    SymbolValue j(j_);
+
+    MinMaxSet symbols(Minimum);
+    symbols.insert(i.clone());
+    symbols.insert(i.clone());
+    PSYCHE_EXPECT_INT_EQ(1, symbols.size());
+
+    MinMaxSet products(Minimum);
+    products.insert(i * j);
+    products.insert(i * j);
+    PSYCHE_EXPECT_INT_EQ(1, products.size());
+
+    MinMaxSet flattened(Minimum);
+    flattened.insert(j.clone());
+    flattened.insert(std::make_unique<NAryValue>(j.clone(), j.clone(), Minimum));
+    PSYCHE_EXPECT_INT_EQ(1, flattened.size());
+    compareText("j", flattened.toValue()->toString());
+}
+
+void Tester::testCaseRA36() // an array access in the loop condition
+{
+    std::string source = R"raw(
+ void foo(int *a, int n) {
+   int i = 0;
+   while (a[i] < n) {
+     i = i + 1;
+   }
+ }
+        )raw";
+
+    // The access is recorded by the visits of the condition that save the
+    // state (when true and when false), not by the probes of the loop.
+    std::string expected = R"raw(
+a[1] : 2
+a[1] : [0, +Inf]
+    )raw";
+
+    std:string output = getArrayAccesses(source);
+
+    compareText(expected, output);
+}
+
+void Tester::testCaseRA37() // the integer constants of a function are thresholds
+{
+    std::string source = R"raw(
+ void foo() {
+   int i, k = 0x40;
+   long m = 010 + 99999999999999999999;
+   float x = 2.5f;
+   for (i = 0; i < 10UL; i++)
+     x = x * 1e3;
+ }
+        )raw";
+
+    std::string expected = R"raw(
+0 8 10 64
+    )raw";
+
+    std::string output = analyseRanges(source, [](RangeAnalysis& rangeAnalysis) {
+        std::string ret = "";
+        for (auto constant : rangeAnalysis.functionConstants_)
+            ret += std::to_string(constant) + " ";
+        return ret;
+    });
+
+    compareText(expected, output);
+}
+
+// Dense graphs
+
+void Tester::testCaseDG1() // removal: insertion order, ids not reused, edges fixed up
+{
+    DenseGraph<std::string> graph;
+    const auto a = graph.insertVertex("a");
+    const auto b = graph.insertVertex("b");
+    const auto c = graph.insertVertex("c");
+    const auto d = graph.insertVertex("d");
+    graph.insertEdge(a, b);
+    graph.insertEdge(b, c);
+    graph.insertEdge(a, c);
+    graph.insertEdge(d, b);
+
+    graph.removeVertex(b);
+    PSYCHE_EXPECT_STR_EQ(std::string("a=0 c=2 d=3 "), verticesText(graph));
+    PSYCHE_EXPECT_INT_EQ(3, graph.size());
+    PSYCHE_EXPECT_INT_EQ(DenseGraph<std::string>::npos, graph.id("b"));
+    PSYCHE_EXPECT_TRUE(graph.outNeighbors(a) == std::vector<unsigned>({ c }));
+    PSYCHE_EXPECT_TRUE(graph.inNeighbors(c) == std::vector<unsigned>({ a }));
+    PSYCHE_EXPECT_INT_EQ(0, graph.outDegree(d));
+
+    // A vertex inserted again gets a new id, and comes last.
+    PSYCHE_EXPECT_INT_EQ(4, graph.insertVertex("b"));
+    PSYCHE_EXPECT_INT_EQ(5, graph.insertVertex("e"));
+    PSYCHE_EXPECT_STR_EQ(std::string("a=0 c=2 d=3 b=4 e=5 "), verticesText(graph));
+    PSYCHE_EXPECT_INT_EQ(6, graph.capacity());
+}
+
+void Tester::testCaseDG2() // CSR: the edges leaving and entering a vertex, and their labels
+{
+    DenseGraph<std::string> graph;
+    const auto a = graph.insertVertex("a");
+    const auto b = graph.insertVertex("b");
+    const auto c = graph.insertVertex("c");
+    graph.insertEdge(a, b, 2);
+    graph.insertEdge(a, b, 1);
+    graph.insertEdge(a, b, 2);
+    graph.insertEdge(a, c);
+    graph.insertEdge(c, b, 0);
+
+    graph.freeze();
+    PSYCHE_EXPECT_TRUE(graph.frozen());
+    PSYCHE_EXPECT_STR_EQ(std::string("b(1 2) c() "), edgesText(graph, graph.outEdges(a)));
+    PSYCHE_EXPECT_STR_EQ(std::string(""), edgesText(graph, graph.outEdges(b)));
+    PSYCHE_EXPECT_STR_EQ(std::string("b(0) "), edgesText(graph, graph.outEdges(c)));
+    PSYCHE_EXPECT_STR_EQ(std::string(""), edgesText(graph, graph.inEdges(a)));
+    PSYCHE_EXPECT_STR_EQ(std::string("a(1 2) c(0) "), edgesText(graph, graph.inEdges(b)));
+    PSYCHE_EXPECT_STR_EQ(std::string("a() "), edgesText(graph, graph.inEdges(c)));
+
+    // The edges entering b share the labels of the ones leaving a and c.
+    PSYCHE_EXPECT_TRUE(graph.labels(*graph.inEdges(b).begin()).begin()
+                       == graph.labels(*graph.outEdges(a).begin()).begin());
+}
+
+void Tester::testCaseDG3() // a mutation thaws the graph, freezing it again packs the new edges
+{
+    DenseGraph<std::string> graph;
+    const auto a = graph.insertVertex("a");
+    const auto b = graph.insertVertex("b");
+    graph.insertEdge(a, b, 1);
+    graph.freeze();
+
+    const auto c = graph.insertVertex("c");
+    PSYCHE_EXPECT_FALSE(graph.frozen());
+    graph.insertEdge(c, a, 5);
+    graph.insertEdge(b, c);
+    graph.freeze();
+    PSYCHE_EXPECT_STR_EQ(std::string("b(1) "), edgesText(graph, graph.outEdges(a)));
+    PSYCHE_EXPECT_STR_EQ(std::string("c() "), edgesText(graph, graph.outEdges(b)));
+    PSYCHE_EXPECT_STR_EQ(std::string("a(5) "), edgesText(graph, graph.outEdges(c)));
+    PSYCHE_EXPECT_STR_EQ(std::string("c(5) "), edgesText(graph, graph.inEdges(a)));
+
+    graph.removeVertex(b);
+    PSYCHE_EXPECT_FALSE(graph.frozen());
+    graph.freeze();
+    PSYCHE_EXPECT_STR_EQ(std::string(""), edgesText(graph, graph.outEdges(a)));
+    PSYCHE_EXPECT_STR_EQ(std::string(""), edgesText(graph, graph.inEdges(c)));
+    PSYCHE_EXPECT_STR_EQ(std::string("c(5) "), edgesText(graph, graph.inEdges(a)));
+}
+
+// Value table
+
+void Tester::testCaseVT1() // Ranges of the same bounds share their nodes
+{
+    SymbolValue i(i_);
+    SymbolValue j(j_);
+
+    Range range1(i + one, j + two);
+    const std::size_t size = ValueTable::instance().size();
+    Range range2(i + one, j + two);
+    PSYCHE_EXPECT_INT_EQ(size, ValueTable::instance().size());
+    PSYCHE_EXPECT_TRUE(range1.lower_ == range2.lower_);
+    PSYCHE_EXPECT_TRUE(range1.upper_ == range2.upper_);
+
+    Range range3(i + two, j + two);
+    PSYCHE_EXPECT_FALSE(range1.lower_ == range3.lower_);
+    PSYCHE_EXPECT_TRUE(range1.upper_ == range3.upper_);
+}
+
+void Tester::testCaseVT2() // printing a shared node doesn't simplify it
+{
+    SymbolValue i(i_);
+
+    Range range1(NAryValue(i.clone(), one.clone(), Multiplication).clone(), i.clone());
+    Range range2(NAryValue(i.clone(), one.clone(), Multiplication).clone(), i.clone());
+    PSYCHE_EXPECT_TRUE(range1.lower_ == range2.lower_);
+
+    PSYCHE_EXPECT_STR_EQ(std::string("i"), range1.lower_->toString());
+    PSYCHE_EXPECT_STR_EQ(std::string("(i)"), range1.lower_->toCCode());
+    const NAryValue& lower = static_cast<const NAryValue&>(*range2.lower_);
+    PSYCHE_EXPECT_INT_EQ(2, lower.terms_.size());
+
+    range1.lower_->buildSymbolDependence();
+    PSYCHE_EXPECT_INT_EQ(1, range2.lower_->symbolDep_.count(i_));
+}
+
+void Tester::testCaseVT3() // evaluate and develop: a formula seen before is a hit
+{
+    SymbolValue i(i_);
+    SymbolValue j(j_);
+    SymbolValue k(k_);
+    ValueTable& table = ValueTable::instance();
+    table.clear();
+
+    AV first = NAryValue(i.clone(), j.clone(), k.clone(), Maximum).evaluate();
+    ValueTable::Stats stats = table.stats();
+    PSYCHE_EXPECT_TRUE(stats.evaluateMisses_ > 0);
+    AV second = NAryValue(i.clone(), j.clone(), k.clone(), Maximum).evaluate();
+    PSYCHE_EXPECT_INT_EQ(stats.evaluateHits_ + 1, table.stats().evaluateHits_);
+    PSYCHE_EXPECT_INT_EQ(stats.evaluateMisses_, table.stats().evaluateMisses_);
+    PSYCHE_EXPECT_STR_EQ(first->toString(), second->toString());
+
+    first = NAryValue(i + j, k.clone(), Multiplication).develop();
+    stats = table.stats();
+    PSYCHE_EXPECT_TRUE(stats.developMisses_ > 0);
+    second = NAryValue(i + j, k.clone(), Multiplication).develop();
+    PSYCHE_EXPECT_INT_EQ(stats.developHits_ + 1, table.stats().developHits_);
+    PSYCHE_EXPECT_INT_EQ(stats.developMisses_, table.stats().developMisses_);
+    PSYCHE_EXPECT_STR_EQ(first->toString(), second->toString());
+}
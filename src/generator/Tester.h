@@ -624,6 +624,36 @@ public:
     void testCaseRA28();
     void testCaseRA29();
     void testCaseRA30();
+    void testCaseRA31();
+    void testCaseRA32();
+    void testCaseRA33();
+    void testCaseRA34();
+    void testCaseRA35();
+    void testCaseRA36();
+    void testCaseRA37();
+
+    // Linear forms
+    void testCaseLV1(); // fromValue
+    void testCaseLV2(); // fromValue, not affine
+    void testCaseLV3(); // toValue
+    void testCaseLV4(); // add
+    void testCaseLV5(); // scale
+    void testCaseLV6(); // overflows
+
+    // Operands of min and max
+    void testCaseMM1(); // dominated
+    void testCaseMM2(); // incomparable
+    void testCaseMM3(); // equal
+
+    // Dense graphs
+    void testCaseDG1(); // removal
+    void testCaseDG2(); // CSR
+    void testCaseDG3(); // freezing again
+
+    // Value table
+    void testCaseVT1(); // interning
+    void testCaseVT2(); // shared nodes
+    void testCaseVT3(); // normal forms
 private:
     using TestData = std::pair<std::function<void(Tester*)>, const char*>;
 
@@ -1079,6 +1109,32 @@ private:
         PSYCHE_TEST(testCaseRA28),
         PSYCHE_TEST(testCaseRA29),
         PSYCHE_TEST(testCaseRA30),
+        PSYCHE_TEST(testCaseRA31),
+        PSYCHE_TEST(testCaseRA32),
+        PSYCHE_TEST(testCaseRA33),
+        PSYCHE_TEST(testCaseRA34),
+        PSYCHE_TEST(testCaseRA35),
+        PSYCHE_TEST(testCaseRA36),
+        PSYCHE_TEST(testCaseRA37),
+
+        PSYCHE_TEST(testCaseLV1),
+        PSYCHE_TEST(testCaseLV2),
+        PSYCHE_TEST(testCaseLV3),
+        PSYCHE_TEST(testCaseLV4),
+        PSYCHE_TEST(testCaseLV5),
+        PSYCHE_TEST(testCaseLV6),
+
+        PSYCHE_TEST(testCaseMM1),
+        PSYCHE_TEST(testCaseMM2),
+        PSYCHE_TEST(testCaseMM3),
+
+        PSYCHE_TEST(testCaseDG1),
+        PSYCHE_TEST(testCaseDG2),
+        PSYCHE_TEST(testCaseDG3),
+
+        PSYCHE_TEST(testCaseVT1),
+        PSYCHE_TEST(testCaseVT2),
+        PSYCHE_TEST(testCaseVT3),
 
         // test some simplifications
         // multiplication (here some cases using the distribution)
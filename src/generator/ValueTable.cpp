@@ -0,0 +1,179 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+#include "ValueTable.h"
+#include "Range.h"
+#include <algorithm>
+
+using namespace psyche;
+
+namespace {
+
+// Distinguish the keys of the unordered ids from the ordered ones.
+const uint8_t kUnorderedTag = 0x80;
+
+bool isCommutative(Operation op)
+{
+    return op == Addition || op == Multiplication
+            || op == Minimum || op == Maximum;
+}
+
+} // anonymous
+
+ValueTable& ValueTable::instance()
+{
+    static thread_local ValueTable table;
+    return table;
+}
+
+std::size_t ValueTable::KeyHash::operator()(const Key& key) const
+{
+    uint64_t h = (uint64_t(key.kind_) << 8) | key.tag_;
+    h = h * 0x9e3779b97f4a7c15ULL ^ key.payload_;
+    for (Id child : key.children_)
+        h = (h ^ child) * 0x100000001b3ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+}
+
+ValueTable::Id ValueTable::idOf(const AbstractValue& value, bool unordered)
+{
+    Key key;
+    key.kind_ = value.getKindOfValue();
+    if (unordered)
+        key.tag_ = kUnorderedTag;
+
+    switch (value.getKindOfValue()) {
+    case KInteger:
+        key.payload_ = static_cast<uint64_t>(static_cast<const IntegerValue&>(value).getValue());
+        break;
+
+    case KSymbol: {
+        const SymbolValue& sv = static_cast<const SymbolValue&>(value);
+        // SymbolValue::operator== compares the names: two symbols of the same
+        // name (from two scopes) are the same unordered value.
+        if (unordered)
+            key.payload_ = symbolNames_.emplace(sv.toString(), symbolNames_.size()).first->second;
+        else
+            key.payload_ = reinterpret_cast<uintptr_t>(sv.getSymbol());
+        break;
+    }
+
+    case KInfinity:
+        key.payload_ = static_cast<const InfinityValue&>(value).getSign();
+        break;
+
+    case KNAry: {
+        const NAryValue& nv = static_cast<const NAryValue&>(value);
+        key.tag_ |= nv.op_;
+        key.children_.reserve(nv.terms_.size());
+        for (auto& term : nv.terms_)
+            key.children_.push_back(idOf(*term, unordered));
+        if (unordered && isCommutative(nv.op_))
+            std::sort(key.children_.begin(), key.children_.end());
+        break;
+    }
+
+    case KUnary: {
+        const UnaryValue& uv = static_cast<const UnaryValue&>(value);
+        key.tag_ |= uv.op_;
+        key.children_.push_back(idOf(*uv.value_, unordered));
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    auto it = ids_.find(key);
+    if (it != ids_.end())
+        return it->second;
+
+    const Id id = static_cast<Id>(nodes_.size());
+    nodes_.emplace_back();
+    ids_.emplace(std::move(key), id);
+    return id;
+}
+
+std::shared_ptr<const AbstractValue> ValueTable::intern(std::unique_ptr<AbstractValue> value)
+{
+    if (!value)
+        return nullptr;
+
+    const Id id = idOf(*value);
+    if (auto node = nodes_[id].lock())
+        return node;
+
+    std::shared_ptr<const AbstractValue> node(std::move(value));
+    nodes_[id] = node;
+    return node;
+}
+
+std::unique_ptr<AbstractValue> ValueTable::normalForm(Id id, NormalForm form)
+{
+    const auto& forms = normalForms_[form];
+    const bool hit = id < forms.size() && forms[id];
+    if (form == Evaluated)
+        ++(hit ? stats_.evaluateHits_ : stats_.evaluateMisses_);
+    else
+        ++(hit ? stats_.developHits_ : stats_.developMisses_);
+
+    return hit ? forms[id]->clone() : nullptr;
+}
+
+void ValueTable::setNormalForm(Id id, NormalForm form, const AbstractValue& value)
+{
+    auto& forms = normalForms_[form];
+    if (id >= forms.size())
+        forms.resize(nodes_.size());
+    forms[id] = value.clone();
+}
+
+void ValueTable::clear()
+{
+    ids_.clear();
+    symbolNames_.clear();
+    nodes_.clear();
+    normalForms_[Evaluated].clear();
+    normalForms_[Developed].clear();
+    stats_.reset();
+}
+
+void ValueTable::Stats::reset()
+{
+    evaluateHits_ = 0;
+    evaluateMisses_ = 0;
+    developHits_ = 0;
+    developMisses_ = 0;
+}
+
+namespace psyche {
+
+std::ostream& operator<<(std::ostream& os, const ValueTable::Stats& s)
+{
+    os << "  Evaluate hits  : " << s.evaluateHits_ << std::endl
+       << "  Evaluate misses: " << s.evaluateMisses_ << std::endl
+       << "  Develop hits   : " << s.developHits_ << std::endl
+       << "  Develop misses : " << s.developMisses_;
+    return os;
+}
+
+} // namespace psyche
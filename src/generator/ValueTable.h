@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright (c) 2017 Marcus Rodrigues de Araújo (demaroar@gmail.com)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ *****************************************************************************/
+
+#ifndef PSYCHE_VALUETABLE_H__
+#define PSYCHE_VALUETABLE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace psyche {
+
+class AbstractValue;
+
+/*!
+ * \brief The ValueTable class
+ *
+ * Unique table of the AbstractValue trees. Each structure gets an id from
+ * its (kind, operation/payload, children ids), so two trees have the same id
+ * iff they are built the same way, and computing it never clones anything.
+ *
+ * The table also keeps one canonical node per id: Ranges hold these nodes,
+ * so copying a Range is copying two pointers, and two Ranges built from the
+ * same expression share their bounds.
+ *
+ * Last, the table caches the normal forms (evaluated and developed) of the
+ * NAryValues by id, so normalising a formula seen before is a lookup.
+ *
+ * There is one table per thread.
+ */
+class ValueTable final
+{
+public:
+    using Id = uint32_t;
+
+    static ValueTable& instance();
+
+    /*!
+     * \brief idOf
+     *
+     * The structural id of \a value. With \a unordered, the operands of
+     * commutative operations (+, *, min and max) are taken as a multiset,
+     * and the symbols are told apart by their names, which matches what
+     * AbstractValue::operator== considers equal.
+     */
+    Id idOf(const AbstractValue& value, bool unordered = false);
+
+    /*!
+     * \brief intern
+     *
+     * Return the canonical node of \a value's structure; \a value itself
+     * becomes the canonical node if there's none alive.
+     */
+    std::shared_ptr<const AbstractValue> intern(std::unique_ptr<AbstractValue> value);
+
+    enum NormalForm : uint8_t
+    {
+        Evaluated,
+        Developed
+    };
+
+    /*!
+     * \brief normalForm
+     *
+     * A copy of the cached normal form of the value with the given id, or
+     * null if it was never computed.
+     */
+    std::unique_ptr<AbstractValue> normalForm(Id id, NormalForm form);
+    void setNormalForm(Id id, NormalForm form, const AbstractValue& value);
+
+    struct Stats
+    {
+        unsigned int evaluateHits_ { 0 };
+        unsigned int evaluateMisses_ { 0 };
+        unsigned int developHits_ { 0 };
+        unsigned int developMisses_ { 0 };
+
+        void reset();
+    };
+
+    Stats stats() const { return stats_; }
+
+    std::size_t size() const { return ids_.size(); }
+
+    //! Forget everything, values of a former program included.
+    void clear();
+
+private:
+    struct Key
+    {
+        bool operator==(const Key& other) const
+        {
+            return kind_ == other.kind_ && tag_ == other.tag_
+                    && payload_ == other.payload_
+                    && children_ == other.children_;
+        }
+
+        uint8_t kind_ { 0 };
+        uint8_t tag_ { 0 };
+        uint64_t payload_ { 0 };
+        std::vector<Id> children_;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    std::unordered_map<Key, Id, KeyHash> ids_;
+    //! The payloads of the unordered symbols, by name.
+    std::unordered_map<std::string, uint64_t> symbolNames_;
+    std::vector<std::weak_ptr<const AbstractValue> > nodes_;
+    std::vector<std::unique_ptr<AbstractValue> > normalForms_[2];
+    Stats stats_;
+};
+
+std::ostream& operator<<(std::ostream& os, const ValueTable::Stats& s);
+
+} // namespace psyche
+
+#endif
@@ -20,27 +20,33 @@
 #ifndef PSYCHE_VERSIONEDMAP_H__
 #define PSYCHE_VERSIONEDMAP_H__
 
-#include <algorithm>
+#include "PersistentMap.h"
 #include <cstdint>
 #include <vector>
-#include <unordered_map>
 
 namespace psyche {
 
 /*!
  * A versioned map.
+ *
+ * Every modification yields a new revision. Revisions are kept as snapshots
+ * of a persistent map, so they share their structure and switching between
+ * them is a matter of picking another root.
  */
 template <class KeyT, class ValueT>
 class VersionedMap
 {
 private:
-    using BaseMap = std::unordered_map<KeyT, ValueT>;
+    using BaseMap = PersistentMap<KeyT, ValueT>;
 
 public:
-    using iterator = typename BaseMap::iterator;
     using const_iterator = typename BaseMap::const_iterator;
+    using iterator = const_iterator;
+
+    //! An immutable view of the map at a given revision.
+    using Snapshot = BaseMap;
 
-    VersionedMap() = default;
+    VersionedMap() : revisions_(1) {}
 
     void insertOrAssign(const KeyT& key, const ValueT& value);
     void insertOrAssign(const KeyT& key, ValueT&& value);
@@ -48,6 +54,9 @@ public:
     void applyRevision(uint32_t revision);
     uint32_t revision() const { return curRevision_; }
 
+    //! The current content, which remains valid after further modifications.
+    const Snapshot& snapshot() const { return map_; }
+
     // Basic traversal.
     const_iterator begin() const { return map_.begin(); }
     const_iterator end() const { return map_.end(); }
@@ -56,41 +65,18 @@ public:
     const_iterator find(const KeyT& key) const { return map_.find(key); }
 
 private:
-    void insertOrAssignCore(const KeyT& key, const ValueT& value);
-    void insertOrAssignCore(const KeyT& key, ValueT&& value);
-
-    // Encapsulates the action, as GoF's command pattern.
-    struct Command
-    {
-        enum OpCode
-        {
-            Insert,
-            Remove
-        };
-
-        Command(const KeyT& key, const ValueT& value, OpCode code)
-            : key_(key), value_(value), opCode_(code)
-        {}
-        const KeyT key_;
-        const ValueT value_;
-        OpCode opCode_;
-    };
-
-    void storeCommand(const Command& command);
-
-    //! Commands for each given revision.
-    std::vector<Command> commands_;
+    void storeRevision();
 
     //!@{
     /*!
-     * Revisioning mechanism.
+     * Revisioning mechanism: the i-th entry is the map at revision i, the
+     * first one being the empty map.
      */
     uint32_t curRevision_ { 0 };
-    uint32_t revisionCnt_ { 0 };
-    std::unordered_map<uint32_t, uint32_t> reverts_;
+    std::vector<BaseMap> revisions_;
     //!@}
 
-    //! The actual underlying map.
+    //! The map at the current revision.
     BaseMap map_;
 };
 
@@ -98,69 +84,33 @@ template <class KeyT, class ValueT>
 void VersionedMap<KeyT, ValueT>::insertOrAssign(const KeyT& key,
                                                 const ValueT& value)
 {
-    storeCommand(Command(key, value, Command::Insert));
-    insertOrAssignCore(key, value);
-}
-
-template <class KeyT, class ValueT>
-void VersionedMap<KeyT, ValueT>::insertOrAssignCore(const KeyT& key,
-                                                    const ValueT& value)
-{
-    map_[key] = value;
+    map_ = map_.insertOrAssign(key, value);
+    storeRevision();
 }
 
 template <class KeyT, class ValueT>
 void VersionedMap<KeyT, ValueT>::insertOrAssign(const KeyT& key,
                                                 ValueT&& value)
 {
-    storeCommand(Command(key, value, Command::Insert));
-    insertOrAssignCore(key, std::move(value));
-}
-
-template <class KeyT, class ValueT>
-void VersionedMap<KeyT, ValueT>::insertOrAssignCore(const KeyT& key,
-                                                    ValueT&& value)
-{
-    // We don't want to use operator[] because this would require ValueT to
-    // have a default constructor (Range, for instance, doesn't have one, and
-    // this is by design). C++17 has already insert_or_assign.
-    auto it = map_.find(key);
-    if (it != map_.end())
-        it->second = std::move(value);
-    else
-        map_.insert(std::make_pair(key, std::move(value)));
+    map_ = map_.insertOrAssign(key, std::move(value));
+    storeRevision();
 }
 
 template <class KeyT, class ValueT>
-void VersionedMap<KeyT, ValueT>::storeCommand(const Command& command)
+void VersionedMap<KeyT, ValueT>::storeRevision()
 {
-    commands_.push_back(command);
-    reverts_.insert(std::make_pair(++revisionCnt_, curRevision_));
-    curRevision_ = revisionCnt_;
+    revisions_.push_back(map_);
+    curRevision_ = static_cast<uint32_t>(revisions_.size() - 1);
 }
 
 template <class KeyT, class ValueT>
 void VersionedMap<KeyT, ValueT>::applyRevision(uint32_t revision)
 {
-    std::vector<uint32_t> ordered;
-    auto it = reverts_.find(revision);
-    while (it != reverts_.end()) {
-        ordered.push_back(it->second);
-        it = reverts_.find(it->second);
-    }
+    if (revision >= revisions_.size())
+        return;
 
     curRevision_ = revision;
-    if (ordered.empty())
-        return; // Nothing to do.
-
-    std::reverse(ordered.begin(), ordered.end());
-    map_.clear();
-    for (auto current : ordered) {
-        const auto& command = commands_[current];
-        ValueT value = command.value_;
-        if (command.opCode_ == Command::Insert)
-            insertOrAssignCore(command.key_, std::move(value));
-    }
+    map_ = revisions_[revision];
 }
 
 } // namespace psyche
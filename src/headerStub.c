@@ -4,9 +4,98 @@
 #include <stdarg.h>
 #include <time.h>
 #include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
 
 int INVALID_RAND;
 
+// Counter-based generator: the i-th number of a test is a hash (the
+// splitmix64 finalizer) of the key of the run and of the counter i, so a
+// test can be replayed from the seed of the run and its number alone, and
+// the numbers of a fill are independent from each other.
+uint64_t RNG_KEY, RNG_COUNTER;
+
+static inline uint64_t rng_mix(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static inline uint64_t rng_at(uint64_t counter)
+{
+    return rng_mix(RNG_KEY + counter * 0x9e3779b97f4a7c15ULL);
+}
+
+// Start the numbers of the given test of the run seeded with seed. Each test
+// has 2^40 numbers of its own.
+void rng_seed(uint64_t seed, int test)
+{
+    RNG_KEY = rng_mix(seed);
+    RNG_COUNTER = (uint64_t) test << 40;
+}
+
+uint64_t rng_next(void)
+{
+    return rng_at(RNG_COUNTER++);
+}
+
+// Map x to [a, b], a <= b, with a multiplication instead of a modulo.
+static inline int rng_map(uint64_t x, int a, int b)
+{
+    uint64_t range = (uint64_t) ((int64_t) b - a) + 1;
+    return (int) ((int64_t) a + (int64_t) (((unsigned __int128) x * range) >> 64));
+}
+
+// A bound at INT_MIN or INT_MAX stands for no bound at all: the numbers are
+// then drawn within UNBOUNDED_INT_RANGE of the other bound, or in
+// [-UNBOUNDED_INT_RANGE, UNBOUNDED_INT_RANGE] if there is none, so that an
+// unconstrained loop count doesn't run the function for 2^31 steps.
+#ifndef UNBOUNDED_INT_RANGE
+#define UNBOUNDED_INT_RANGE 100
+#endif
+
+static inline void rng_bound(int *a, int *b)
+{
+    if (*a == INT_MIN && *b == INT_MAX) {
+        *a = -UNBOUNDED_INT_RANGE;
+        *b = UNBOUNDED_INT_RANGE;
+    } else if (*b == INT_MAX) {
+        *b = *a > INT_MAX - UNBOUNDED_INT_RANGE ? INT_MAX : *a + UNBOUNDED_INT_RANGE;
+    } else if (*a == INT_MIN) {
+        *a = *b < INT_MIN + UNBOUNDED_INT_RANGE ? INT_MIN : *b - UNBOUNDED_INT_RANGE;
+    }
+}
+
+// Fill ptr[0], ..., ptr[n - 1] with numbers of [lo, hi].
+#define FILL_RANGE(type, ptr, n, lo, hi) \
+    do { \
+        type *fill_ptr_ = (ptr); \
+        size_t fill_i_, fill_n_ = (n); \
+        int fill_lo_ = (lo), fill_hi_ = (hi); \
+        rng_bound(&fill_lo_, &fill_hi_); \
+        for (fill_i_ = 0; fill_i_ < fill_n_; fill_i_++) \
+            fill_ptr_[fill_i_] = rng_map(rng_at(RNG_COUNTER + fill_i_), fill_lo_, fill_hi_); \
+        RNG_COUNTER += fill_n_; \
+    } while (0)
+
+#define DEFINE_FILL_RANGE(name, type) \
+    void name(type *ptr, size_t n, int lo, int hi) { FILL_RANGE(type, ptr, n, lo, hi); }
+
+DEFINE_FILL_RANGE(fill_int_range, int)
+DEFINE_FILL_RANGE(fill_float_range, float)
+DEFINE_FILL_RANGE(fill_double_range, double)
+
 int msqrt(int x)
 {
     // Base cases
@@ -37,18 +126,973 @@ int msqrt(int x)
 }
 
 int rand_a_b(int a, int b){
-    if (b == INT_MAX) {
-	return a + rand();
-    }
-    if (a == INT_MIN) {
-	return (rand() - INT_MAX) % b;
-    }
-    if ((b-a)+1 <= 0) {
+    if (b < a) {
 	INVALID_RAND = 1;
 	fprintf(stderr, "range void [%d, %d].\n", a, b);
 	return 0;
     }
-    return rand()%(b-a+1) + a;
+    rng_bound(&a, &b);
+    return rng_map(rng_next(), a, b);
+}
+
+// Size of the dimensions chosen by a sweep, at its current point, kept in
+// [a, b] for the dimensions that have to be larger or smaller.
+int SWEEP_SIZE;
+
+int sweep_size(int a, int b)
+{
+    if (b < a)
+        return rand_a_b(a, b);
+    return SWEEP_SIZE < a ? a : SWEEP_SIZE > b ? b : SWEEP_SIZE;
+}
+
+// Bump allocator for the arrays of a test, released all at once by
+// arena_reset() at the end of the test. The block is allocated once, before
+// the first test; what doesn't fit in it is malloc'ed and freed on reset.
+#define ARENA_ALIGN sizeof(long double)
+#ifndef ARENA_MAX_BYTES
+#define ARENA_MAX_BYTES ((size_t) 1 << 28)
+#endif
+#ifndef ARENA_EVICT_BYTES
+#define ARENA_EVICT_BYTES ((size_t) 1 << 25)
+#endif
+
+char *ARENA;
+size_t ARENA_SIZE, ARENA_USED;
+struct arena_spill { void *block; size_t bytes; } *ARENA_SPILLS;
+size_t ARENA_NB_SPILLS, ARENA_MAX_SPILLS;
+
+int arena_init(size_t bytes)
+{
+    if (bytes > ARENA_MAX_BYTES)
+        bytes = ARENA_MAX_BYTES;
+    ARENA = malloc(bytes + ARENA_ALIGN);
+    ARENA_SIZE = ARENA ? bytes : 0;
+    ARENA_USED = 0;
+    return ARENA != NULL;
+}
+
+void *arena_alloc(size_t bytes)
+{
+    void *p;
+
+    bytes = (bytes + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+    if (bytes <= ARENA_SIZE - ARENA_USED) {
+        p = ARENA + ARENA_USED;
+        ARENA_USED += bytes;
+        return p;
+    }
+
+    if (ARENA_NB_SPILLS == ARENA_MAX_SPILLS) {
+        size_t max = ARENA_MAX_SPILLS ? 2 * ARENA_MAX_SPILLS : 64;
+        struct arena_spill *spills = realloc(ARENA_SPILLS, max * sizeof(*spills));
+        if (!spills)
+            return NULL;
+        ARENA_SPILLS = spills;
+        ARENA_MAX_SPILLS = max;
+    }
+    p = malloc(bytes + 1);
+    if (p) {
+        ARENA_SPILLS[ARENA_NB_SPILLS].block = p;
+        ARENA_SPILLS[ARENA_NB_SPILLS++].bytes = bytes;
+    }
+    return p;
+}
+
+void arena_reset(void)
+{
+    while (ARENA_NB_SPILLS)
+        free(ARENA_SPILLS[--ARENA_NB_SPILLS].block);
+    ARENA_USED = 0;
+}
+
+// Upper bound of what an array of dims dimensions, each with at most extent
+// elements, takes in the arena: as contiguous_alloc lays it out if
+// contiguous, with one block per row otherwise.
+size_t arena_bound(size_t elemSize, int dims, int extent, int contiguous)
+{
+    size_t rows = 1, bytes = 0, row;
+    int d;
+
+    if (contiguous) {
+        for (d = 0; d < dims - 1; d++) {
+            rows *= extent;
+            bytes += rows * sizeof(void *);
+        }
+        return bytes + ARENA_ALIGN + rows * extent * elemSize;
+    }
+
+    row = (extent * sizeof(void *) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+    for (d = 0; d < dims; d++) {
+        bytes += rows * row;
+        rows *= extent;
+    }
+    return bytes;
+}
+
+// Evict the arrays of the test from the caches, so that the function under
+// test starts cold.
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+
+static void flush_lines(const char *p, size_t bytes)
+{
+    size_t i;
+    for (i = 0; i < bytes; i += 64)
+        _mm_clflush(p + i);
+}
+
+void flush_cache(const void *p, size_t bytes)
+{
+    flush_lines(p, bytes);
+    _mm_mfence();
+}
+
+void arena_flush_cache(void)
+{
+    size_t i;
+    flush_lines(ARENA, ARENA_USED);
+    for (i = 0; i < ARENA_NB_SPILLS; i++)
+        flush_lines(ARENA_SPILLS[i].block, ARENA_SPILLS[i].bytes);
+    _mm_mfence();
+}
+#else
+// No way to flush given lines: walk a buffer larger than the caches.
+static void evict_caches(void)
+{
+    static volatile char *evict;
+    size_t i;
+
+    if (!evict)
+        evict = malloc(ARENA_EVICT_BYTES);
+    if (!evict)
+        return;
+    for (i = 0; i < ARENA_EVICT_BYTES; i += 64)
+        evict[i]++;
+}
+
+void flush_cache(const void *p, size_t bytes)
+{
+    evict_caches();
+}
+
+void arena_flush_cache(void)
+{
+    evict_caches();
+}
+#endif
+
+// Layout of contiguous_alloc: the number of bytes of the tables, and of the
+// elements.
+static void contiguous_size(size_t elemSize, int dims, const int *extents,
+                            size_t *tables, size_t *elements)
+{
+    size_t rows = 1;
+    int d;
+
+    *tables = 0;
+    for (d = 0; d < dims - 1; d++) {
+        rows *= extents[d] > 0 ? extents[d] : 0;
+        *tables += rows;
+    }
+    *elements = rows * (extents[dims - 1] > 0 ? extents[dims - 1] : 0) * elemSize;
+
+    // The elements are aligned as malloc would align them.
+    *tables *= sizeof(void *);
+    *tables = (*tables + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+}
+
+// Fill the tables of pointers, from block, to the rows of the elements at
+// data.
+static void *contiguous_tables(char *block, char *data, size_t elemSize,
+                               int dims, const int *extents)
+{
+    size_t rows, next, i;
+    void **table;
+    int d;
+
+    table = (void **) block;
+    rows = 1;
+    for (d = 0; d < dims - 1; d++) {
+        rows *= extents[d] > 0 ? extents[d] : 0;
+        next = extents[d + 1] > 0 ? extents[d + 1] : 0;
+        for (i = 0; i < rows; i++) {
+            if (d == dims - 2)
+                table[i] = data + i * next * elemSize;
+            else
+                table[i] = table + rows + i * next;
+        }
+        table += rows;
+    }
+
+    return dims > 1 ? (void *) block : (void *) data;
+}
+
+static void *contiguous_layout(char *block, size_t tables, size_t elemSize,
+                               int dims, const int *extents)
+{
+    if (!block)
+        return NULL;
+    return contiguous_tables(block, block + tables, elemSize, dims, extents);
+}
+
+// Allocate an array of dims dimensions, with extents[i] elements along the
+// i-th one, in a single block to release with free(). The block starts with
+// the tables of pointers (the first dimension's one first), each pointing
+// into the next one, followed by the elements in row-major order.
+void *contiguous_alloc(size_t elemSize, int dims, const int *extents)
+{
+    size_t tables, elements;
+    contiguous_size(elemSize, dims, extents, &tables, &elements);
+    return contiguous_layout(malloc(tables + elements + 1), tables, elemSize, dims, extents);
+}
+
+// Same as contiguous_alloc, in the arena.
+void *arena_contiguous_alloc(size_t elemSize, int dims, const int *extents)
+{
+    size_t tables, elements;
+    contiguous_size(elemSize, dims, extents, &tables, &elements);
+    return contiguous_layout(arena_alloc(tables + elements), tables, elemSize, dims, extents);
+}
+
+// Guard pages: each block of the arrays of a test is mapped on its own,
+// between two inaccessible pages, and placed flush against the one after it
+// (before it if GUARD_START), so that the first access out of the block
+// faults. guard_fault then tells which array and which test it was.
+int GUARD_START, GUARD_TEST;
+struct guard_region {
+    char *base, *begin, *end;
+    size_t size;
+    const char *name;
+} *GUARD_REGIONS;
+size_t GUARD_NB_REGIONS, GUARD_MAX_REGIONS;
+// Mappings released by guard_free, reused by the next tests rather than
+// mapped again: most of the small arrays take a single page. The larger ones
+// are unmapped, their pages would stay resident in the cache.
+#define GUARD_CACHE_SIZE 4096
+#define GUARD_CACHE_MAX_BYTES ((size_t) 1 << 16)
+struct guard_region GUARD_CACHE[GUARD_CACHE_SIZE];
+size_t GUARD_NB_CACHED;
+
+static void guard_fault(int sig, siginfo_t *info, void *context)
+{
+    char *addr = info->si_addr, msg[256];
+    size_t i;
+    int n;
+
+    for (i = 0; i < GUARD_NB_REGIONS; i++) {
+        struct guard_region *r = &GUARD_REGIONS[i];
+        if (addr < r->base || addr >= r->base + r->size)
+            continue;
+        if (addr >= r->end)
+            n = snprintf(msg, sizeof(msg), "test %d: out-of-bounds access to %s, %ld byte(s) after its end\n",
+                         GUARD_TEST, r->name, (long) (addr - r->end));
+        else
+            n = snprintf(msg, sizeof(msg), "test %d: out-of-bounds access to %s, %ld byte(s) before its start\n",
+                         GUARD_TEST, r->name, (long) (r->begin - addr));
+        write(STDERR_FILENO, msg, n);
+        _exit(3);
+    }
+    // Not in a guard page, fault again without the handler.
+    signal(sig, SIG_DFL);
+}
+
+void guard_init(int start)
+{
+    struct sigaction action;
+
+    GUARD_START = start;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = guard_fault;
+    action.sa_flags = SA_SIGINFO;
+    sigaction(SIGSEGV, &action, NULL);
+    sigaction(SIGBUS, &action, NULL);
+}
+
+// Allocate bytes for the array name, aligned on align (a power of 2).
+void *guard_alloc(size_t bytes, size_t align, const char *name)
+{
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t data = (bytes + page - 1) / page * page;
+    struct guard_region *r;
+    char *base;
+    size_t i;
+
+    if (GUARD_NB_REGIONS == GUARD_MAX_REGIONS) {
+        size_t max = GUARD_MAX_REGIONS ? 2 * GUARD_MAX_REGIONS : 64;
+        r = realloc(GUARD_REGIONS, max * sizeof(*r));
+        if (!r)
+            return NULL;
+        GUARD_REGIONS = r;
+        GUARD_MAX_REGIONS = max;
+    }
+    base = NULL;
+    for (i = GUARD_NB_CACHED; i--; ) {
+        if (GUARD_CACHE[i].size == data + 2 * page) {
+            base = GUARD_CACHE[i].base;
+            GUARD_CACHE[i] = GUARD_CACHE[--GUARD_NB_CACHED];
+            break;
+        }
+    }
+    if (!base) {
+        base = mmap(NULL, data + 2 * page, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            fprintf(stderr, "test %d: cannot map %zu bytes for %s with guard pages (%s)\n",
+                    GUARD_TEST, data + 2 * page, name, strerror(errno));
+            return NULL;
+        }
+        if (data && mprotect(base + page, data, PROT_READ | PROT_WRITE)) {
+            fprintf(stderr, "test %d: cannot map %zu bytes for %s with guard pages (%s)\n",
+                    GUARD_TEST, data + 2 * page, name, strerror(errno));
+            munmap(base, data + 2 * page);
+            return NULL;
+        }
+    }
+
+    r = &GUARD_REGIONS[GUARD_NB_REGIONS++];
+    r->base = base;
+    r->size = data + 2 * page;
+    r->name = name;
+    if (GUARD_START)
+        r->begin = base + page;
+    else
+        r->begin = (char *) ((uintptr_t) (base + page + data - bytes) & ~(uintptr_t) (align - 1));
+    r->end = r->begin + bytes;
+    return r->begin;
+}
+
+void guard_free(void *ptr)
+{
+    size_t i = GUARD_NB_REGIONS;
+
+    while (i--) {
+        if ((char *) ptr >= GUARD_REGIONS[i].base &&
+            (char *) ptr < GUARD_REGIONS[i].base + GUARD_REGIONS[i].size) {
+            if (GUARD_NB_CACHED < GUARD_CACHE_SIZE && GUARD_REGIONS[i].size <= GUARD_CACHE_MAX_BYTES)
+                GUARD_CACHE[GUARD_NB_CACHED++] = GUARD_REGIONS[i];
+            else
+                munmap(GUARD_REGIONS[i].base, GUARD_REGIONS[i].size);
+            GUARD_REGIONS[i] = GUARD_REGIONS[--GUARD_NB_REGIONS];
+            return;
+        }
+    }
+}
+
+// Same as contiguous_alloc, with guard pages: the elements end (or the
+// tables start) on the guard page.
+void *guard_contiguous_alloc(size_t elemSize, int dims, const int *extents, const char *name)
+{
+    size_t tables, elements;
+    char *block, *data;
+
+    contiguous_size(elemSize, dims, extents, &tables, &elements);
+    block = guard_alloc(tables + elements + ARENA_ALIGN, 1, name);
+    if (!block || GUARD_START)
+        return contiguous_layout(block, tables, elemSize, dims, extents);
+    data = block + tables + ARENA_ALIGN;
+    block = (char *) ((uintptr_t) (data - tables) & ~(uintptr_t) (ARENA_ALIGN - 1));
+    return contiguous_layout(block, data - block, elemSize, dims, extents);
+}
+
+// Latency of the calls of a test, in nanoseconds of the raw monotonic
+// clock (not slewed by NTP, unlike CLOCK_MONOTONIC).
+#ifndef CLOCK_MONOTONIC_RAW
+#define CLOCK_MONOTONIC_RAW CLOCK_MONOTONIC
+#endif
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &t);
+    return (uint64_t) t.tv_sec * 1000000000ULL + t.tv_nsec;
+}
+
+struct latency { double min, median, p99, mean; };
+
+static int compare_ns(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+// Summarize the n samples of ns (sorted in place), nearest-rank percentiles.
+void latency_stats(double *ns, int n, struct latency *out)
+{
+    double sum = 0;
+    int i;
+
+    if (n <= 0) {
+        out->min = out->median = out->p99 = out->mean = 0;
+        return;
+    }
+    qsort(ns, n, sizeof(double), compare_ns);
+    for (i = 0; i < n; i++)
+        sum += ns[i];
+    out->min = ns[0];
+    out->median = ns[(n - 1) / 2];
+    out->p99 = ns[(99 * n + 99) / 100 - 1];
+    out->mean = sum / n;
+}
+
+// Results of the tests, one row per test, gathered in a large buffer and
+// written in big chunks so that writing them doesn't disturb the timings.
+// As text (CSV), or packed: every column takes 8 bytes (an int64_t, a
+// uint64_t or a double), after a header giving the name and the kind of
+// each column (RESULTS_INT, RESULTS_UINT or RESULTS_DOUBLE).
+#define RESULTS_MAGIC "GRFNRES1"
+#define RESULTS_BUFFER (1 << 20)
+// The most bytes of a value, in text.
+#define RESULTS_FIELD 64
+#define RESULTS_INT 'i'
+#define RESULTS_UINT 'u'
+#define RESULTS_DOUBLE 'f'
+
+struct results_column {
+    char name[31];
+    char kind;
+};
+
+struct results {
+    FILE *file;
+    int binary, first;
+    size_t used;
+    char buffer[RESULTS_BUFFER];
+};
+
+void results_flush(struct results *r)
+{
+    fwrite(r->buffer, 1, r->used, r->file);
+    r->used = 0;
+}
+
+// Room for one more value, its separator and the end of the row.
+static char *results_room(struct results *r)
+{
+    if (r->used + 2 + RESULTS_FIELD + 1 > RESULTS_BUFFER)
+        results_flush(r);
+    if (!r->binary && !r->first) {
+        r->buffer[r->used++] = ',';
+        r->buffer[r->used++] = ' ';
+    }
+    r->first = 0;
+    return r->buffer + r->used;
+}
+
+void results_init(struct results *r, FILE *file, int binary)
+{
+    r->file = file;
+    r->binary = binary;
+    r->first = 1;
+    r->used = 0;
+}
+
+// The header of the packed results: the names (separated with ", ") and the
+// kinds of the columns.
+void results_header(FILE *file, const char *names, const char *kinds)
+{
+    struct results_column column;
+    uint32_t nb = strlen(kinds);
+    const char *next;
+    size_t length;
+
+    fwrite(RESULTS_MAGIC, 1, 8, file);
+    fwrite(&nb, sizeof(nb), 1, file);
+    for (; *kinds; kinds++) {
+        memset(&column, 0, sizeof(column));
+        next = strstr(names, ", ");
+        length = next ? (size_t) (next - names) : strlen(names);
+        memcpy(column.name, names, length < sizeof(column.name) ? length : sizeof(column.name) - 1);
+        column.kind = *kinds;
+        fwrite(&column, sizeof(column), 1, file);
+        names = next ? next + 2 : names + length;
+    }
+}
+
+static size_t results_digits(char *p, unsigned long long v)
+{
+    char digits[20];
+    size_t n = 0, i;
+
+    do {
+        digits[n++] = '0' + v % 10;
+        v /= 10;
+    } while (v);
+    for (i = 0; i < n; i++)
+        p[i] = digits[n - 1 - i];
+    return n;
+}
+
+void results_uint(struct results *r, unsigned long long v)
+{
+    char *p = results_room(r);
+
+    if (r->binary) {
+        uint64_t u = v;
+        memcpy(p, &u, sizeof(u));
+        r->used += sizeof(u);
+        return;
+    }
+    r->used += results_digits(p, v);
+}
+
+void results_int(struct results *r, long long v)
+{
+    char *p = results_room(r);
+
+    if (r->binary) {
+        int64_t i = v;
+        memcpy(p, &i, sizeof(i));
+        r->used += sizeof(i);
+        return;
+    }
+    if (v < 0) {
+        *p++ = '-';
+        r->used++;
+        r->used += results_digits(p, 0ULL - (unsigned long long) v);
+        return;
+    }
+    r->used += results_digits(p, v);
+}
+
+// As text, with the given number of decimals.
+void results_double(struct results *r, double v, int decimals)
+{
+    char *p = results_room(r);
+    unsigned long long scale = 1, scaled;
+    int i;
+
+    if (r->binary) {
+        memcpy(p, &v, sizeof(v));
+        r->used += sizeof(v);
+        return;
+    }
+    for (i = 0; i < decimals; i++)
+        scale *= 10;
+    if (!(v > -1e12 && v < 1e12)) {
+        // snprintf returns the length it would have written: a value past the
+        // field is cut to what it actually wrote.
+        int n = snprintf(p, RESULTS_FIELD, "%.*f", decimals, v);
+        r->used += n < RESULTS_FIELD ? n : RESULTS_FIELD - 1;
+        return;
+    }
+    if (v < 0) {
+        *p++ = '-';
+        r->used++;
+        v = -v;
+    }
+    scaled = (unsigned long long) (v * scale + 0.5);
+    i = results_digits(p, scaled / scale);
+    if (decimals) {
+        p[i++] = '.';
+        scaled %= scale;
+        for (scale /= 10; scale; scale /= 10) {
+            p[i++] = '0' + scaled / scale;
+            scaled %= scale;
+        }
+    }
+    r->used += i;
+}
+
+void results_end_row(struct results *r)
+{
+    if (!r->binary)
+        r->buffer[r->used++] = '\n';
+    r->first = 1;
+}
+
+// Corpus of the inputs of the tests, written by "./main --record FILE" and
+// read back by "./main --replay FILE". The file starts with a header and the
+// shape of each array, followed by one record per test: a corpus_record,
+// the scalars, then the extents and the elements (in row-major order) of
+// each array. The extents and the elements start on CORPUS_ALIGN bytes, so
+// that the replay uses the elements in place, from the mapping of the file.
+#define CORPUS_MAGIC "GRFNCRP1"
+#define CORPUS_ALIGN 16
+
+struct corpus_header {
+    char magic[8];
+    uint32_t nb_arrays, nb_scalars;
+};
+
+struct corpus_shape {
+    char name[48];
+    uint32_t elem_size, dims;
+};
+
+struct corpus_record {
+    uint64_t bytes; // of the record, this header included
+    uint64_t seed, rng_key, rng_counter;
+    int32_t test, unused;
+};
+
+struct corpus {
+    FILE *file;
+    long record;
+    char *base, *current, *cursor, *next, *end;
+    struct corpus_table { void *block; size_t bytes; } *tables;
+    size_t nb_tables, max_tables;
+};
+
+static void corpus_pad(struct corpus *c)
+{
+    static const char zeros[CORPUS_ALIGN];
+    long offset = ftell(c->file);
+    fwrite(zeros, 1, (CORPUS_ALIGN - offset % CORPUS_ALIGN) % CORPUS_ALIGN, c->file);
+}
+
+static char *corpus_align(const struct corpus *c, char *p)
+{
+    return c->base + ((p - c->base) + CORPUS_ALIGN - 1) / CORPUS_ALIGN * CORPUS_ALIGN;
+}
+
+// Start a corpus of the arrays names (a NULL-terminated list), whose elements
+// take elemSizes bytes, along dims dimensions.
+int corpus_create(struct corpus *c, const char *path, int nbScalars,
+                  const char **names, const int *elemSizes, const int *dims)
+{
+    struct corpus_header header;
+    struct corpus_shape shape;
+    int i;
+
+    memset(c, 0, sizeof(*c));
+    c->file = fopen(path, "wb");
+    if (!c->file) {
+        perror(path);
+        return 0;
+    }
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CORPUS_MAGIC, sizeof(header.magic));
+    for (i = 0; names[i]; i++)
+        header.nb_arrays++;
+    header.nb_scalars = nbScalars;
+    fwrite(&header, sizeof(header), 1, c->file);
+    for (i = 0; names[i]; i++) {
+        memset(&shape, 0, sizeof(shape));
+        strncpy(shape.name, names[i], sizeof(shape.name) - 1);
+        shape.elem_size = elemSizes[i];
+        shape.dims = dims[i];
+        fwrite(&shape, sizeof(shape), 1, c->file);
+    }
+    return 1;
+}
+
+// Start the record of the test, once its inputs are drawn: the replay
+// restarts the generator from there, for the stubs.
+void corpus_begin(struct corpus *c, unsigned long long seed, int test)
+{
+    struct corpus_record record;
+
+    corpus_pad(c);
+    c->record = ftell(c->file);
+    memset(&record, 0, sizeof(record));
+    record.seed = seed;
+    record.rng_key = RNG_KEY;
+    record.rng_counter = RNG_COUNTER;
+    record.test = test;
+    fwrite(&record, sizeof(record), 1, c->file);
+}
+
+void corpus_put(struct corpus *c, const void *p, size_t bytes)
+{
+    fwrite(p, 1, bytes, c->file);
+}
+
+// The extents of the next array, followed by its elements.
+void corpus_put_shape(struct corpus *c, int dims, const int *extents)
+{
+    corpus_pad(c);
+    fwrite(extents, sizeof(int), dims, c->file);
+    corpus_pad(c);
+}
+
+void corpus_end(struct corpus *c)
+{
+    uint64_t bytes;
+    long end;
+
+    corpus_pad(c);
+    end = ftell(c->file);
+    bytes = end - c->record;
+    fseek(c->file, c->record, SEEK_SET);
+    fwrite(&bytes, sizeof(bytes), 1, c->file);
+    fseek(c->file, end, SEEK_SET);
+}
+
+// Map the corpus, checking that it was recorded by a main with the same
+// arrays. The mapping is private: what the function writes in the arrays
+// isn't written back.
+int corpus_open(struct corpus *c, const char *path, int nbScalars,
+                const char **names, const int *elemSizes, const int *dims)
+{
+    struct corpus_header *header;
+    struct corpus_shape *shape;
+    struct stat st;
+    int fd, i;
+
+    memset(c, 0, sizeof(*c));
+    fd = open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st)) {
+        perror(path);
+        return 0;
+    }
+    c->base = st.st_size ? mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0)
+                         : MAP_FAILED;
+    close(fd);
+    if (c->base == MAP_FAILED || (size_t) st.st_size < sizeof(*header)) {
+        fprintf(stderr, "%s: not a corpus\n", path);
+        return 0;
+    }
+    c->end = c->base + st.st_size;
+
+    header = (struct corpus_header *) c->base;
+    shape = (struct corpus_shape *) (header + 1);
+    for (i = 0; names[i]; i++)
+        ;
+    if (memcmp(header->magic, CORPUS_MAGIC, sizeof(header->magic)) ||
+        header->nb_arrays != (uint32_t) i || header->nb_scalars != (uint32_t) nbScalars ||
+        (char *) (shape + i) > c->end) {
+        fprintf(stderr, "%s: not a corpus of this main\n", path);
+        return 0;
+    }
+    for (i = 0; names[i]; i++) {
+        if (strncmp(shape[i].name, names[i], sizeof(shape[i].name) - 1) ||
+            shape[i].elem_size != (uint32_t) elemSizes[i] || shape[i].dims != (uint32_t) dims[i]) {
+            fprintf(stderr, "%s: array %s differs from the one of the corpus\n", path, names[i]);
+            return 0;
+        }
+    }
+    c->next = corpus_align(c, (char *) (shape + i));
+    return 1;
+}
+
+// Move to the record of the next test, 0 at the end of the corpus.
+int corpus_next(struct corpus *c, unsigned long long *seed, int *test)
+{
+    struct corpus_record *record = (struct corpus_record *) c->next;
+
+    if ((char *) (record + 1) > c->end || !record->bytes || c->next + record->bytes > c->end)
+        return 0;
+    RNG_KEY = record->rng_key;
+    RNG_COUNTER = record->rng_counter;
+    *seed = record->seed;
+    *test = record->test;
+    c->current = c->next;
+    c->cursor = (char *) (record + 1);
+    c->next += record->bytes;
+    return 1;
+}
+
+static void corpus_mismatch(const struct corpus *c)
+{
+    const struct corpus_record *record = (const struct corpus_record *) c->current;
+    fprintf(stderr, "corpus: the record of test %d doesn't match the arrays\n", (int) record->test);
+}
+
+// Whether the bytes at p are in the record being replayed, which corpus_next
+// checked against the end of the mapping.
+static int corpus_fits(const struct corpus *c, const char *p, size_t bytes)
+{
+    const struct corpus_record *record = (const struct corpus_record *) c->current;
+    const char *end = c->current + record->bytes;
+
+    if (p <= end && bytes <= (size_t) (end - p))
+        return 1;
+    corpus_mismatch(c);
+    return 0;
+}
+
+// The next scalar of the record, 0 past its end.
+int corpus_get(struct corpus *c, void *p, size_t bytes)
+{
+    if (!corpus_fits(c, c->cursor, bytes))
+        return 0;
+    memcpy(p, c->cursor, bytes);
+    c->cursor += bytes;
+    return 1;
+}
+
+// The next array of the record, in place, NULL past its end. A pointer array
+// (pointers set) gets tables of pointers to its rows, released by
+// corpus_release.
+void *corpus_array(struct corpus *c, size_t elemSize, int dims, int pointers)
+{
+    size_t tables, elements, rows = 1;
+    const int *extents;
+    char *data, *block;
+    int d;
+
+    extents = (const int *) corpus_align(c, c->cursor);
+    if (!corpus_fits(c, (const char *) extents, dims * sizeof(int)))
+        return NULL;
+    // The rows and the tables to them can't overflow, whatever the extents.
+    for (d = 0; d < dims; d++) {
+        if (extents[d] > 0 && rows > SIZE_MAX / (sizeof(void *) + elemSize) / dims / extents[d]) {
+            corpus_mismatch(c);
+            return NULL;
+        }
+        rows *= extents[d] > 0 ? extents[d] : 1;
+    }
+    data = corpus_align(c, (char *) (extents + dims));
+    contiguous_size(elemSize, dims, extents, &tables, &elements);
+    if (!corpus_fits(c, data, elements))
+        return NULL;
+    c->cursor = data + elements;
+    if (!pointers || dims == 1)
+        return data;
+
+    if (c->nb_tables == c->max_tables) {
+        size_t max = c->max_tables ? 2 * c->max_tables : 16;
+        struct corpus_table *all = realloc(c->tables, max * sizeof(*all));
+        if (!all)
+            return NULL;
+        c->tables = all;
+        c->max_tables = max;
+    }
+    block = malloc(tables + 1);
+    if (!block)
+        return NULL;
+    c->tables[c->nb_tables].block = block;
+    c->tables[c->nb_tables++].bytes = tables;
+    return contiguous_tables(block, data, elemSize, dims, extents);
+}
+
+// Release the tables of the arrays of the test.
+void corpus_release(struct corpus *c)
+{
+    while (c->nb_tables)
+        free(c->tables[--c->nb_tables].block);
+}
+
+// Evict the arrays of the test being replayed (the record and the tables of
+// its pointer arrays) from the caches.
+void corpus_flush_cache(const struct corpus *c)
+{
+    size_t i;
+
+    for (i = 0; i < c->nb_tables; i++)
+        flush_cache(c->tables[i].block, c->tables[i].bytes);
+    flush_cache(c->current, c->next - c->current);
+}
+
+void corpus_close(struct corpus *c)
+{
+    if (c->file)
+        fclose(c->file);
+    if (c->base)
+        munmap(c->base, c->end - c->base);
+    free(c->tables);
+}
+
+// Split the tests [*first, *last) between workers processes, each one with a
+// consecutive share of them. Returns the number of the worker in each of
+// them, with its share in [*first, *last), and -1 in the parent once all of
+// them are done, with the status of the first one that failed in *status.
+// The numbers of a test only depend on the seed and on the test, so the
+// results are the same as with a single process.
+int fork_workers(int workers, int *first, int *last, int *status)
+{
+    int count = *last - *first, worker, started = 0, s;
+    pid_t pid;
+
+    if (workers > count)
+        workers = count > 0 ? count : 1;
+    fflush(NULL);
+    *status = 0;
+    for (worker = 0; worker < workers; worker++) {
+        pid = fork();
+        if (pid == 0) {
+#ifdef __linux__
+            // Don't outlive a parent killed by a timeout.
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+            *last = *first + (int) ((long) count * (worker + 1) / workers);
+            *first += (int) ((long) count * worker / workers);
+            return worker;
+        }
+        if (pid < 0) {
+            perror("fork");
+            *status = 2;
+            break;
+        }
+        started++;
+    }
+    while (started-- > 0) {
+        if (wait(&s) < 0)
+            break;
+        if (!*status && WIFEXITED(s) && WEXITSTATUS(s))
+            *status = WEXITSTATUS(s);
+        else if (!*status && WIFSIGNALED(s))
+            *status = 128 + WTERMSIG(s);
+    }
+    return -1;
+}
+
+// The CSV of a worker is a shard next to the main one, path.worker.
+FILE *open_shard(const char *path, int worker)
+{
+    char shard[4096];
+    snprintf(shard, sizeof(shard), "%s.%d", path, worker);
+    return fopen(shard, "w");
+}
+
+// Append the shards of the workers to csv, in their order, and remove them.
+void merge_shards(FILE *csv, const char *path, int workers)
+{
+    char shard[4096], buffer[1 << 16];
+    size_t n;
+    int worker;
+    FILE *f;
+
+    for (worker = 0; worker < workers; worker++) {
+        snprintf(shard, sizeof(shard), "%s.%d", path, worker);
+        f = fopen(shard, "r");
+        if (!f)
+            continue;
+        while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0)
+            fwrite(buffer, 1, n, csv);
+        fclose(f);
+        remove(shard);
+    }
+}
+
+// Adaptive number of tests: they stop once the budget (in ms) is spent, or
+// once the 95% confidence interval of the mean of their latencies is within
+// ci (relative, e.g. 0.05) of it, after STOPPING_MIN_TESTS tests. A zero
+// budget or ci disables its rule.
+#define STOPPING_MIN_TESTS 30
+
+struct stopping {
+    uint64_t deadline;
+    double ci, mean, m2;
+    long n;
+};
+
+void stopping_init(struct stopping *s, double budget, double ci)
+{
+    s->deadline = budget > 0 ? now_ns() + (uint64_t) (budget * 1e6) : 0;
+    s->ci = ci;
+    s->mean = s->m2 = 0;
+    s->n = 0;
+}
+
+// Account for the latency of a test, 1 if the tests can stop there.
+int stopping_done(struct stopping *s, double latency)
+{
+    double delta = latency - s->mean;
+
+    // Welford's online mean and variance.
+    s->n++;
+    s->mean += delta / s->n;
+    s->m2 += delta * (latency - s->mean);
+
+    if (s->deadline && now_ns() >= s->deadline)
+        return 1;
+    if (s->ci > 0 && s->n >= STOPPING_MIN_TESTS) {
+        // 1.96 * stddev / sqrt(n) <= ci * mean, squared (no libm).
+        double bound = s->ci * s->mean;
+        return 1.96 * 1.96 * s->m2 / (s->n - 1) / s->n <= bound * bound;
+    }
+    return 0;
 }
 
 int max(int numArgs, ...)
@@ -119,7 +1163,7 @@ void overflow_check(int *term1, int *term2, int only_left) {
     if (only_left) {
       *term1 = *term1 / 2;
     } else {
-      if (rand() % 2) 
+      if (rng_next() & 1) 
         *term1 = *term1 / 2;
       else
         *term2 = *term2 / 2;
@@ -142,7 +1186,7 @@ void fix_product_is_greater(int low, int *term1, int u1, int *term2, int u2)
         //printf("%d <= %d x %d\n", low, *term1, *term2);
         return;
     }
-    if (rand() % 2) {
+    if (rng_next() & 1) {
         if (*term1 == 0)
             *term1 = u1;
         *term2 = max(2, *term2, low / *term1);
@@ -169,7 +1213,7 @@ void fix_product_is_lesser(int up, int *term1, int u1, int *term2, int u2)
         //printf("%d x %d <= %d\n", *term1, *term2, up);
         return;
     }
-    if (rand() % 2) {
+    if (rng_next() & 1) {
         if (*term1 == 0)
             *term1 = u1;
         *term2 = min(2, *term2, up / *term1);
@@ -23,7 +23,7 @@ else
 fi
 mkdir $dir/mains 2> /dev/null 
 echo "Testing file $f.c."
-time ./Gen $dir/$f.c clean 
+time ./Gen --artifacts all $dir/$f.c clean 
 if [[ $? -eq 139 ]]; then
 	echo -e "\033[33m A segmentation fault occurs with file $dir/$f.c\033[0m"
 fi